@@ -0,0 +1,123 @@
+#ifndef T_INLINE_STRING_H
+#define T_INLINE_STRING_H
+
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+#include "Tuple.h"
+
+namespace tpl {
+  /**
+   * String of at most `N` characters stored inside of the object, so it never allocates memory.
+   * It can be used as an element of a `tpl::Tuple` instead of a `std::string`: it is trivially copyable,
+   * and `operator+` gives an `InlineString<N + M>` so the concatenation always fits.
+   * The characters after the end of the string are always `'\0'`, so two equal strings have the same bytes
+   * (which allows the `memcmp` comparison of `tpl::Tuple::equals_impl`).
+   * @tparam N the maximum number of characters
+   */
+  template<std::size_t N>
+  class InlineString {
+    static_assert(N > 0, "The capacity of an InlineString must be greater than 0");
+
+  public:
+    constexpr InlineString() = default;
+
+    /**
+     * Not explicit, like the constructors of `std::string`, so that `tpl::Tuple<tpl::InlineString<N>>` can be constructed from a literal.
+     * @param str the characters to copy
+     * @throws std::length_error if `str` has more than `N` characters
+     */
+    constexpr InlineString(const std::string_view str) {
+      if (str.size() > N)
+        throw std::length_error("tpl::InlineString: capacity exceeded");
+      for (std::size_t i = 0; i < str.size(); ++i)
+        chars[i] = str[i];
+      length = str.size();
+    }
+
+    constexpr InlineString(const char* str) : InlineString(std::string_view(str)) {}
+
+    constexpr std::size_t size() const { return length; }
+    static constexpr std::size_t capacity() { return N; }
+    constexpr bool empty() const { return length == 0; }
+
+    constexpr const char* data() const { return chars; }
+    constexpr std::string_view view() const { return {chars, length}; }
+    constexpr operator std::string_view() const { return view(); }
+
+    /**
+     * Only the characters of the string can be modified, the ones after the end must stay `'\0'`
+     * (see `tpl::is_bitwise_comparable<InlineString<N>>`).
+     * @param idx the index of the character, less than `size()`
+     * @return a reference to the character
+     */
+    constexpr char& operator[](const std::size_t idx) {
+      assert(idx < length && "tpl::InlineString: index out of range");
+      return chars[idx];
+    }
+
+    constexpr const char& operator[](const std::size_t idx) const { return chars[idx]; }
+
+    /**
+     * @tparam M the capacity of the other string
+     * @param other the string to append
+     * @return a new string, big enough to contain the two strings
+     */
+    template<std::size_t M>
+    constexpr InlineString<N + M> operator+(const InlineString<M>& other) const {
+      InlineString<N + M> result(view());
+      result += other;
+      return result;
+    }
+
+    /**
+     * @param other the characters to append
+     * @return the current string
+     * @throws std::length_error if the result has more than `N` characters, the string is then not modified
+     */
+    constexpr InlineString& operator+=(const std::string_view other) {
+      if (other.size() > N - length)
+        throw std::length_error("tpl::InlineString: capacity exceeded");
+      for (std::size_t i = 0; i < other.size(); ++i)
+        chars[length + i] = other[i];
+      length += other.size();
+      return *this;
+    }
+
+    friend constexpr bool operator==(const InlineString& lhs, const std::string_view rhs) { return lhs.view() == rhs; }
+    friend constexpr bool operator==(const std::string_view lhs, const InlineString& rhs) { return lhs == rhs.view(); }
+    friend constexpr bool operator!=(const InlineString& lhs, const std::string_view rhs) { return lhs.view() != rhs; }
+    friend constexpr bool operator!=(const std::string_view lhs, const InlineString& rhs) { return lhs != rhs.view(); }
+    friend constexpr bool operator<(const InlineString& lhs, const std::string_view rhs) { return lhs.view() < rhs; }
+    friend constexpr bool operator<(const std::string_view lhs, const InlineString& rhs) { return lhs < rhs.view(); }
+
+    template<std::size_t M>
+    constexpr bool operator==(const InlineString<M>& other) const { return view() == other.view(); }
+
+    template<std::size_t M>
+    constexpr bool operator!=(const InlineString<M>& other) const { return view() != other.view(); }
+
+    /**
+     * Only `operator<` is needed by the lexicographic comparison of `tpl::Tuple`.
+     */
+    template<std::size_t M>
+    constexpr bool operator<(const InlineString<M>& other) const { return view() < other.view(); }
+
+    friend std::ostream& operator<<(std::ostream& os, const InlineString& str) { return os << str.view(); }
+
+  private:
+    char chars[N] = {};
+    std::size_t length = 0;
+  };
+
+  /**
+   * The characters after the end are always `'\0'`, so two equal strings have the same bytes.
+   */
+  template<std::size_t N>
+  struct is_bitwise_comparable<InlineString<N>> : std::true_type {};
+}
+
+#endif // T_INLINE_STRING_H
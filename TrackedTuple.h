@@ -0,0 +1,178 @@
+#ifndef T_TRACKED_TUPLE_H
+#define T_TRACKED_TUPLE_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "Tuple.h"
+
+namespace tpl {
+  /**
+   * A `tpl::Tuple` remembering which of its elements were modified since the last call to `clearDirty`.
+   * The values derived from the whole tuple (hash, serialized form, sums, ...) can then be updated with `forEachDirty`
+   * by only recomputing the part coming from the modified elements.
+   * @tparam Types the types of the elements contained in the tuple
+   */
+  template<typename ... Types>
+  class TrackedTuple {
+  public:
+    TrackedTuple() = default;
+
+    /**
+     * @param args the arguments to initialize the tuple, no element is marked as modified
+     */
+    template<typename NotUsedType = void, typename = std::enable_if_t<(sizeof...(Types) > 0), NotUsedType>>
+    explicit TrackedTuple(const Types&... args) : values(args...) {}
+
+    /**
+     * @param values the initial values of the tuple, no element is marked as modified
+     */
+    explicit TrackedTuple(const Tuple<Types...>& values) : values(values) {}
+
+    /**
+     * The element is marked as modified, because the reference can be used to modify it.
+     * Use the `const` version (or `tuple()`) to only read it.
+     * @tparam Idx the index of the element
+     * @return a reference to the element
+     */
+    template<std::size_t Idx>
+    auto& get() {
+      dirty.set(Idx);
+      return values.template get<Idx>();
+    }
+
+    template<std::size_t Idx>
+    const auto& get() const { return values.template get<Idx>(); }
+
+    /**
+     * Contrary to `get`, the element is only marked as modified if its value changes.
+     * @tparam Idx the index of the element
+     * @tparam Value the type of the new value
+     * @param value the new value of the element
+     */
+    template<std::size_t Idx, typename Value>
+    void set(Value&& value) {
+      auto& element = values.template get<Idx>();
+      if (!(element == value)) {
+        element = std::forward<Value>(value);
+        dirty.set(Idx);
+      }
+    }
+
+    /**
+     * @return the tuple, to use the operators of `tpl::Tuple` without modifying it
+     */
+    const Tuple<Types...>& tuple() const { return values; }
+
+    /**
+     * see `tpl::Tuple::operator+=`, only the trivially copyable elements whose bytes change are marked as modified
+     * (so a NaN is not marked after `+= 0.0`, but `-0.0` is marked after `+= 0.0`), the other elements (`std::string`, ...)
+     * are always marked because copying them to detect the change would cost more than the operation.
+     * @tparam OtherTypes the types of the elements contained in the other tuple
+     * @param other the other tuple
+     * @return the current tuple
+     */
+    template <typename ... OtherTypes>
+    TrackedTuple& operator+=(const Tuple<OtherTypes...>& other) {
+      return apply_impl(other, [](auto& lhs, const auto& rhs) { lhs += rhs; }, std::make_index_sequence<sizeof...(Types)>{});
+    }
+
+    /**
+     * see `tpl::TrackedTuple::operator+=`
+     */
+    template <typename ... OtherTypes>
+    TrackedTuple& operator-=(const Tuple<OtherTypes...>& other) {
+      return apply_impl(other, [](auto& lhs, const auto& rhs) { lhs -= rhs; }, std::make_index_sequence<sizeof...(Types)>{});
+    }
+
+    /**
+     * see `tpl::TrackedTuple::operator+=`
+     */
+    template <typename ... OtherTypes>
+    TrackedTuple& operator*=(const Tuple<OtherTypes...>& other) {
+      return apply_impl(other, [](auto& lhs, const auto& rhs) { lhs *= rhs; }, std::make_index_sequence<sizeof...(Types)>{});
+    }
+
+    /**
+     * see `tpl::TrackedTuple::operator+=`
+     */
+    template <typename ... OtherTypes>
+    TrackedTuple& operator/=(const Tuple<OtherTypes...>& other) {
+      return apply_impl(other, [](auto& lhs, const auto& rhs) { lhs /= rhs; }, std::make_index_sequence<sizeof...(Types)>{});
+    }
+
+    template<std::size_t Idx>
+    bool isDirty() const { return dirty.test(Idx); }
+
+    bool anyDirty() const { return dirty.any(); }
+
+    const std::bitset<sizeof...(Types)>& dirtyMask() const { return dirty; }
+
+    void clearDirty() { dirty.reset(); }
+
+    /**
+     * Call `func(std::integral_constant<std::size_t, Idx>{}, element)` for each modified element, the index is given as a type
+     * so that `func` can use it at compile time (to access a cache with `std::get`, ...).
+     * The elements stay marked as modified, call `clearDirty` once the derived values are up to date.
+     * @tparam Func the type of the function
+     * @param func the function called for each modified element
+     */
+    template<typename Func>
+    void forEachDirty(Func&& func) const {
+      for_each_dirty_impl(func, std::make_index_sequence<sizeof...(Types)>{});
+    }
+
+  private:
+    /**
+     * Apply `op` to each couple of elements and mark as modified the elements of the current tuple which may have changed.
+     * The bytes of the trivially copyable elements are compared with a copy of their previous value, `operator==` is not
+     * used because a NaN is never equal to itself. The other elements are marked without being copied.
+     * @tparam Idx A `std:size_t...`. A pack of index generated by `std::index_sequence`.
+     * @tparam OtherTypes The pack of types corresponding to the elements of the tuple given in arguments.
+     * @tparam Op the type of the operation
+     * @param other the other tuple used to do the operation
+     * @param op the operation, modifying its first argument
+     * @return the current tuple
+     */
+    template<std::size_t... Idx, typename ... OtherTypes, typename Op>
+    TrackedTuple& apply_impl(const Tuple<OtherTypes...>& other, Op op, std::index_sequence<Idx...>) {
+      ([&] {
+        auto& element = values.template get<Idx>();
+        using Element = std::decay_t<decltype(element)>;
+        if constexpr (std::is_trivially_copyable_v<Element>) {
+          const Element previous = element;
+          op(element, other.template get<Idx>());
+          if (std::memcmp(static_cast<const void*>(&element), static_cast<const void*>(&previous), sizeof(Element)) != 0)
+            dirty.set(Idx);
+        } else {
+          op(element, other.template get<Idx>());
+          dirty.set(Idx);
+        }
+      }(), ...);
+      return *this;
+    }
+
+    template<typename Func, std::size_t... Idx>
+    void for_each_dirty_impl(Func& func, std::index_sequence<Idx...>) const {
+      ((dirty.test(Idx) ? static_cast<void>(func(std::integral_constant<std::size_t, Idx>{}, values.template get<Idx>())) : void()), ...);
+    }
+
+    Tuple<Types...> values;
+    std::bitset<sizeof...(Types)> dirty;
+  };
+
+  /**
+   * @tparam Types the types of the elements
+   * @param args the values to put insides of the tuple
+   * @return a tracked tuple made with the given values, with no element marked as modified
+   */
+  template <class... Types>
+  TrackedTuple<std::decay_t<Types>...> makeTrackedTuple(Types&&... args) {
+    return TrackedTuple<std::decay_t<Types>...>(std::forward<Types>(args)...);
+  }
+}
+
+#endif // T_TRACKED_TUPLE_H
@@ -1,15 +1,87 @@
 #ifndef T_TUPLE_H
 #define T_TUPLE_H
 
+#include <array>
 #include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
 namespace tpl {
+  /**
+   * Construct an object of type `T` from `args`, passing `alloc` to it if `T` is allocator-aware
+   * (uses-allocator construction, cf <a href="https://en.cppreference.com/w/cpp/memory/uses_allocator">cppreference.com/...</a>).
+   * The object is returned by value, the copy elision guarantee of C++17 allows to initialize a member with it directly.
+   * @tparam T the type of the object to construct
+   * @tparam Alloc the type of the allocator
+   * @tparam Args the types of the arguments given to the constructor of `T`
+   * @param alloc the allocator to give to the object if it uses it
+   * @param args the arguments given to the constructor of `T`
+   * @return the constructed object
+   */
+  template<typename T, typename Alloc, typename... Args>
+  T construct_with_allocator(const Alloc& alloc, Args&&... args) {
+    if constexpr (!std::uses_allocator_v<T, Alloc>) {
+      return T(std::forward<Args>(args)...);
+    } else if constexpr (std::is_constructible_v<T, std::allocator_arg_t, const Alloc&, Args...>) {
+      return T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+    } else {
+      return T(std::forward<Args>(args)..., alloc);
+    }
+  }
+
+  /**
+   * Tell if `T` is a view: a type referring to data it does not own (`std::string_view`, ...).
+   * It can be specialized for other view types.
+   * @tparam T the type to check
+   */
+  template<typename T>
+  struct is_view : std::false_type {};
+
+  template<typename CharT, typename Traits>
+  struct is_view<std::basic_string_view<CharT, Traits>> : std::true_type {};
+
+  template<typename T>
+  inline constexpr bool is_view_v = is_view<T>::value;
+
+  /**
+   * Tell if two values of type `T` are equal (with `operator==`) exactly when their bytes are equal,
+   * which allows `tpl::Tuple::equals_impl` to compare them with `memcmp`.
+   * True by default for the integers, the enumerations and the pointers only, because the `operator==` of a class
+   * can ignore some of its members. A class can specialize it to opt in (see `tpl::InlineString`).
+   * @tparam T the type to check
+   */
+  template<typename T>
+  struct is_bitwise_comparable
+    : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>> {};
+
+  template<typename T>
+  inline constexpr bool is_bitwise_comparable_v = is_bitwise_comparable<T>::value;
+
+  /**
+   * True if one of the `Types` is a view. The result of an operation between two tuples is a temporary tuple,
+   * so a view in it would refer to data owned by nobody (or by an operand destroyed at the end of the expression).
+   * @tparam Types the types to check
+   */
+  template<typename... Types>
+  inline constexpr bool has_view_v = (is_view_v<std::decay_t<Types>> || ...);
+
   template<std::size_t Idx, typename... Types>
   struct Tuple_Impl;
 
   template<std::size_t Idx>
-  struct Tuple_Impl<Idx> {};
+  struct Tuple_Impl<Idx> {
+    Tuple_Impl() = default;
+
+    template<typename Alloc>
+    Tuple_Impl(std::allocator_arg_t, const Alloc&) {}
+  };
 
   template<std::size_t Idx, typename HeadType, typename ... TailTypes>
   struct Tuple_Impl<Idx, HeadType, TailTypes...> : Tuple_Impl<Idx+1, TailTypes...> {
@@ -22,6 +94,32 @@ namespace tpl {
 
     Tuple_Impl() = default;
 
+    /**
+     * Construct every element with the given allocator (see `tpl::construct_with_allocator`).
+     * @tparam Alloc the type of the allocator
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     */
+    template<typename Alloc>
+    Tuple_Impl(std::allocator_arg_t tag, const Alloc& alloc)
+      : Tuple_Impl<Idx+1, TailTypes...>(tag, alloc), value(construct_with_allocator<HeadType>(alloc)) {}
+
+    /**
+     * Construct every element from the given arguments with the given allocator (see `tpl::construct_with_allocator`).
+     * The arguments are forwarded, so an rvalue is moved in the element.
+     * @tparam Alloc the type of the allocator
+     * @tparam HeadArg the type of the argument used to construct the head
+     * @tparam TailArgs the types of the arguments used to construct the tail
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     * @param head the argument used to construct the head
+     * @param tail the arguments used to construct the tail
+     */
+    template<typename Alloc, typename HeadArg, typename... TailArgs>
+    Tuple_Impl(std::allocator_arg_t tag, const Alloc& alloc, HeadArg&& head, TailArgs&&... tail)
+      : Tuple_Impl<Idx+1, TailTypes...>(tag, alloc, std::forward<TailArgs>(tail)...),
+        value(construct_with_allocator<HeadType>(alloc, std::forward<HeadArg>(head))) {}
+
     HeadType& getHead() { return value; }
     const HeadType& getHead() const { return value; }
 
@@ -29,8 +127,77 @@ namespace tpl {
     const Tuple_Impl<Idx+1, TailTypes...>& getTail() const { return *this; }
   };
 
+  /**
+   * True if all the `Types` are the same arithmetic type (`tpl::Tuple<double, double, double>`, ...).
+   * @tparam Types the types of the elements
+   */
+  template<typename... Types>
+  struct is_dense : std::false_type {};
+
+  template<typename HeadType, typename... TailTypes>
+  struct is_dense<HeadType, TailTypes...>
+    : std::bool_constant<std::is_arithmetic_v<HeadType> && (std::is_same_v<HeadType, TailTypes> && ...)> {};
+
+  template<typename... Types>
+  inline constexpr bool is_dense_v = is_dense<Types...>::value;
+
+  /**
+   * Storage of a dense tuple (see `tpl::is_dense`): the elements are in a `std::array`, so they are contiguous and in order,
+   * and the operations are done with loops on the array that the compiler can vectorize.
+   * The array keeps the alignment of the elements, so the size of the tuple does not change.
+   * @tparam HeadType the type of the elements
+   * @tparam TailTypes the same type, once for each other element
+   */
+  template<typename... Types>
+  struct Tuple_Dense;
+
+  template<typename HeadType, typename... TailTypes>
+  struct Tuple_Dense<HeadType, TailTypes...> {
+  private:
+    std::array<HeadType, 1 + sizeof...(TailTypes)> values;
+
+  public:
+    explicit Tuple_Dense(const HeadType& head, const TailTypes&... tail) : values{head, tail...} {}
+
+    Tuple_Dense() = default;
+
+    /**
+     * The arithmetic types do not use allocators, the elements are only value-initialized.
+     */
+    template<typename Alloc>
+    Tuple_Dense(std::allocator_arg_t, const Alloc&) : values{} {}
+
+    template<typename Alloc, typename... Args>
+    Tuple_Dense(std::allocator_arg_t, const Alloc&, Args&&... args) : values{static_cast<HeadType>(args)...} {}
+
+    HeadType* data() { return values.data(); }
+    const HeadType* data() const { return values.data(); }
+
+#if defined(__cpp_lib_span)
+    std::span<HeadType, 1 + sizeof...(TailTypes)> span() { return std::span<HeadType, 1 + sizeof...(TailTypes)>(values); }
+    std::span<const HeadType, 1 + sizeof...(TailTypes)> span() const { return std::span<const HeadType, 1 + sizeof...(TailTypes)>(values); }
+#endif
+  };
+
+  /**
+   * Choose the storage of a tuple: a `tpl::Tuple_Dense` if all the elements have the same arithmetic type, a `tpl::Tuple_Impl` otherwise.
+   * @tparam Types the types of the elements
+   */
+  template<typename... Types>
+  using Tuple_Storage = std::conditional_t<is_dense_v<Types...>, Tuple_Dense<Types...>, Tuple_Impl<0, Types...>>;
+
+  /**
+   * The default constructor, the copies, the moves and the destructor are defaulted,
+   * so a tuple of trivially copyable (or trivially destructible, or trivial) types is trivially copyable (or ...) too.
+   * This allows `std::vector` to move its tuples with `memmove` on growth, and a tuple to be copied with `memcpy` in a buffer.
+   * The elements are stored by inheritance to let the compiler reuse the tail padding of the bases, so a tuple is
+   * not standard layout, but it has unique object representations when its elements have them and there is no padding.
+   * If all the elements have the same arithmetic type, they are stored in a `std::array` instead (see `tpl::Tuple_Dense`),
+   * and the tuple has the methods `data()` (and `span()` in C++20) to access them as a contiguous array.
+   * These methods only exist for the dense tuples, `size()` exists for every tuple.
+   */
   template<typename ... Types>
-  struct Tuple : Tuple_Impl<0, Types...> {
+  struct Tuple : Tuple_Storage<Types...> {
     Tuple() = default;
 
     /**
@@ -43,13 +210,77 @@ namespace tpl {
      * @param args the arguments to initialize the tuple
      */
     template<typename NotUsedType = void, typename = std::enable_if_t<(sizeof...(Types) > 0), NotUsedType>>
-    explicit Tuple(const Types&... args) : Tuple_Impl<0, Types...>(args...) {}
+    explicit Tuple(const Types&... args) : Tuple_Storage<Types...>(args...) {}
+
+    /**
+     * @return the number of elements of the tuple
+     */
+    static constexpr std::size_t size() { return sizeof...(Types); }
+
+    /**
+     * Construct a tuple where each element using an allocator of type `Alloc` (`std::uses_allocator`) is default constructed with `alloc`.
+     * For example, with a `std::pmr::polymorphic_allocator` all the `std::pmr::string` of the tuple are placed in the same memory resource.
+     * @tparam Alloc the type of the allocator
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     */
+    template<typename Alloc>
+    Tuple(std::allocator_arg_t tag, const Alloc& alloc) : Tuple_Storage<Types...>(tag, alloc) {}
+
+    /**
+     * Same as `Tuple(const Types&...)` but each element using an allocator of type `Alloc` is constructed with `alloc`.
+     * @tparam Alloc the type of the allocator
+     * @tparam NotUsedType a dummy type to enable the constructor (see `Tuple(const Types&...)`)
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     * @param args the arguments to initialize the tuple
+     */
+    template<typename Alloc, typename NotUsedType = void, typename = std::enable_if_t<(sizeof...(Types) > 0), NotUsedType>>
+    Tuple(std::allocator_arg_t tag, const Alloc& alloc, const Types&... args) : Tuple_Storage<Types...>(tag, alloc, args...) {}
+
+    /**
+     * Allocator-extended copy constructor, used for example by a `std::pmr::vector<tpl::Tuple<...>>` to give its allocator to the tuples it contains.
+     * @tparam Alloc the type of the allocator
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     * @param other the tuple to copy
+     */
+    template<typename Alloc>
+    Tuple(std::allocator_arg_t tag, const Alloc& alloc, const Tuple& other)
+      : Tuple(tag, alloc, other, std::make_index_sequence<sizeof...(Types)>{}) {}
 
+    /**
+     * Allocator-extended move constructor, see `Tuple(std::allocator_arg_t, const Alloc&, const Tuple&)`.
+     * @tparam Alloc the type of the allocator
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     * @param other the tuple to move
+     */
+    template<typename Alloc>
+    Tuple(std::allocator_arg_t tag, const Alloc& alloc, Tuple&& other)
+      : Tuple(tag, alloc, std::move(other), std::make_index_sequence<sizeof...(Types)>{}) {}
+
+    /**
+     * @tparam Idx the index of the element, checked at compile time
+     * @return a reference to the element
+     */
     template<std::size_t Idx>
-    auto& get() { return get_impl<Idx>(*this); }
+    auto& get() {
+      static_assert(Idx < sizeof...(Types), "tpl::Tuple::get: index out of range");
+      if constexpr (is_dense_v<Types...>)
+        return this->data()[Idx];
+      else
+        return get_impl<Idx>(*this);
+    }
 
     template<std::size_t Idx>
-    const auto& get() const { return get_impl<Idx>(*this); }
+    const auto& get() const {
+      static_assert(Idx < sizeof...(Types), "tpl::Tuple::get: index out of range");
+      if constexpr (is_dense_v<Types...>)
+        return this->data()[Idx];
+      else
+        return get_impl<Idx>(*this);
+    }
 
     /**
      * In the implementation of the `tpl::Tuple::plus_impl` function, the `std::index_sequence<sizeof...(Types)>` given here is used to generate a sequence of indices
@@ -222,6 +453,30 @@ namespace tpl {
 
 
   private:
+    /**
+     * Used by the allocator-extended copy constructor to copy each element of `other`.
+     * @tparam Alloc the type of the allocator
+     * @tparam Idx A `std:size_t...`. A pack of index generated by `std::index_sequence`.
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     * @param other the tuple to copy
+     */
+    template<typename Alloc, std::size_t... Idx>
+    Tuple(std::allocator_arg_t tag, const Alloc& alloc, const Tuple& other, std::index_sequence<Idx...>)
+      : Tuple_Storage<Types...>(tag, alloc, other.template get<Idx>()...) {}
+
+    /**
+     * Used by the allocator-extended move constructor to move each element of `other`.
+     * @tparam Alloc the type of the allocator
+     * @tparam Idx A `std:size_t...`. A pack of index generated by `std::index_sequence`.
+     * @param tag the `std::allocator_arg` tag
+     * @param alloc the allocator given to the elements using it
+     * @param other the tuple to move
+     */
+    template<typename Alloc, std::size_t... Idx>
+    Tuple(std::allocator_arg_t tag, const Alloc& alloc, Tuple&& other, std::index_sequence<Idx...>)
+      : Tuple_Storage<Types...>(tag, alloc, std::move(other.template get<Idx>())...) {}
+
     /**
      * @tparam Idx The index of the element to get
      * @tparam TupleImpl_SubType The subtype of the tuple to get the element from
@@ -257,6 +512,7 @@ namespace tpl {
      *
      * So we create a new Tuple, between `<` and `>` we calculate the new type of element, and between `(` and `)` we calculate the result of the operation.
      * And we do this for every couple of elements in the tuples using the `...` operator.
+     * The `static_assert` rejects at compile time a result containing a view (see `tpl::has_view_v`).
      *
      * @tparam Idx A `std:size_t...`. A pack of index generated by `std::index_sequence`.
      * @tparam OtherTypes The pack of types corresponding to the elements of the tuple given in arguments.
@@ -265,9 +521,35 @@ namespace tpl {
      */
     template<std::size_t... Idx, typename ... OtherTypes>
     auto plus_impl(const Tuple<OtherTypes...>& other, std::index_sequence<Idx...>) const {
-      return Tuple<decltype(this->get<Idx>() + other.template get<Idx>())...>(
-        (this->get<Idx>() + other.template get<Idx>())...
-      );
+      static_assert(!has_view_v<decltype(this->get<Idx>() + other.template get<Idx>())...>,
+        "The result of an operation between two tuples cannot contain a view (std::string_view, ...), it would dangle");
+      if constexpr (is_dense_v<Types...> && is_dense_v<OtherTypes...>) {
+        return dense_apply<Tuple<decltype(this->get<Idx>() + other.template get<Idx>())...>>(
+          other, [](const auto& lhs, const auto& rhs) { return lhs + rhs; }
+        );
+      } else {
+        return Tuple<decltype(this->get<Idx>() + other.template get<Idx>())...>(
+          (this->get<Idx>() + other.template get<Idx>())...
+        );
+      }
+    }
+
+    /**
+     * Used by `plus_impl`, `minus_impl`, ... when the two tuples are dense (see `tpl::Tuple_Dense`):
+     * the result is also dense, so it is computed with a loop on the arrays instead of one expression per element.
+     * @tparam Result the type of the result, a dense tuple
+     * @tparam OtherTypes The pack of types corresponding to the elements of the tuple given in arguments.
+     * @tparam Op the type of the operation
+     * @param other the other tuple used to do the operation
+     * @param op the operation done on each couple of elements
+     * @return A new tuple containing the result of the operation.
+     */
+    template<typename Result, typename ... OtherTypes, typename Op>
+    Result dense_apply(const Tuple<OtherTypes...>& other, Op op) const {
+      Result result;
+      for (std::size_t i = 0; i < sizeof...(Types); ++i)
+        result.data()[i] = op(this->data()[i], other.data()[i]);
+      return result;
     }
 
     /**
@@ -293,9 +575,17 @@ namespace tpl {
      */
     template<std::size_t... Idx, typename ... OtherTypes>
     auto minus_impl(const Tuple<OtherTypes...>& other, std::index_sequence<Idx...>) const {
-      return Tuple<decltype(this->get<Idx>() - other.template get<Idx>())...>(
-        (this->get<Idx>() - other.template get<Idx>())...
-      );
+      static_assert(!has_view_v<decltype(this->get<Idx>() - other.template get<Idx>())...>,
+        "The result of an operation between two tuples cannot contain a view (std::string_view, ...), it would dangle");
+      if constexpr (is_dense_v<Types...> && is_dense_v<OtherTypes...>) {
+        return dense_apply<Tuple<decltype(this->get<Idx>() - other.template get<Idx>())...>>(
+          other, [](const auto& lhs, const auto& rhs) { return lhs - rhs; }
+        );
+      } else {
+        return Tuple<decltype(this->get<Idx>() - other.template get<Idx>())...>(
+          (this->get<Idx>() - other.template get<Idx>())...
+        );
+      }
     }
 
     /**
@@ -320,9 +610,17 @@ namespace tpl {
      */
     template<std::size_t... Idx, typename ... OtherTypes>
     auto times_impl(const Tuple<OtherTypes...>& other, std::index_sequence<Idx...>) const {
-      return Tuple<decltype(this->get<Idx>() * other.template get<Idx>())...>(
-        (this->get<Idx>() * other.template get<Idx>())...
-      );
+      static_assert(!has_view_v<decltype(this->get<Idx>() * other.template get<Idx>())...>,
+        "The result of an operation between two tuples cannot contain a view (std::string_view, ...), it would dangle");
+      if constexpr (is_dense_v<Types...> && is_dense_v<OtherTypes...>) {
+        return dense_apply<Tuple<decltype(this->get<Idx>() * other.template get<Idx>())...>>(
+          other, [](const auto& lhs, const auto& rhs) { return lhs * rhs; }
+        );
+      } else {
+        return Tuple<decltype(this->get<Idx>() * other.template get<Idx>())...>(
+          (this->get<Idx>() * other.template get<Idx>())...
+        );
+      }
     }
 
     /**
@@ -347,9 +645,17 @@ namespace tpl {
      */
     template<std::size_t... Idx, typename ... OtherTypes>
     auto divide_impl(const Tuple<OtherTypes...>& other, std::index_sequence<Idx...>) const {
-      return Tuple<decltype(this->get<Idx>() / other.template get<Idx>())...>(
-        (this->get<Idx>() / other.template get<Idx>())...
-      );
+      static_assert(!has_view_v<decltype(this->get<Idx>() / other.template get<Idx>())...>,
+        "The result of an operation between two tuples cannot contain a view (std::string_view, ...), it would dangle");
+      if constexpr (is_dense_v<Types...> && is_dense_v<OtherTypes...>) {
+        return dense_apply<Tuple<decltype(this->get<Idx>() / other.template get<Idx>())...>>(
+          other, [](const auto& lhs, const auto& rhs) { return lhs / rhs; }
+        );
+      } else {
+        return Tuple<decltype(this->get<Idx>() / other.template get<Idx>())...>(
+          (this->get<Idx>() / other.template get<Idx>())...
+        );
+      }
     }
 
     /**
@@ -368,6 +674,9 @@ namespace tpl {
     /**
      * see tpl::Tuple::plus_impl for the full explanation of std::index_sequence.
      * Here we do not use `decltype` because we only return a bool.
+     * When the two tuples have the same type, all the elements are compared by their bytes (`tpl::is_bitwise_comparable`)
+     * and the tuple has no padding (`std::has_unique_object_representations`), the whole tuples are compared with a single `memcmp`. Else, two dense tuples of the same size are compared with a loop on their arrays.
+     * Else, the elements are compared one by one with `get`: only the first elements of `other` are compared if it is bigger, and it does not compile if it is smaller.
      * @tparam Idx A `std:size_t...`. A pack of index generated by `std::index_sequence`.
      * @tparam OtherTypes The pack of types corresponding to the elements of the tuple given in arguments.
      * @param other the other tuple used to do the operation
@@ -375,7 +684,18 @@ namespace tpl {
      */
     template<std::size_t... Idx, typename ... OtherTypes>
     bool equals_impl(const Tuple<OtherTypes...>& other, std::index_sequence<Idx...>) const {
-      return ((this->get<Idx>() == other.template get<Idx>()) && ...);
+      if constexpr (std::is_same_v<Tuple, Tuple<OtherTypes...>> && std::has_unique_object_representations_v<Tuple>
+                    && (is_bitwise_comparable_v<Types> && ...)) {
+        return std::memcmp(static_cast<const void*>(this), static_cast<const void*>(&other), sizeof(Tuple)) == 0;
+      } else if constexpr (is_dense_v<Types...> && is_dense_v<OtherTypes...> && sizeof...(OtherTypes) == sizeof...(Types)) {
+        // Count the equal elements without early exit, so that the loop can be vectorized.
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < sizeof...(Types); ++i)
+          equal += (this->data()[i] == other.data()[i]);
+        return equal == sizeof...(Types);
+      } else {
+        return ((this->get<Idx>() == other.template get<Idx>()) && ...);
+      }
     }
 
     /**
@@ -421,6 +741,26 @@ namespace tpl {
     }
   };
 
+  /**
+   * Give the number of elements of a `tpl::Tuple`.
+   * @tparam TupleType the type of the tuple
+   */
+  template<typename TupleType>
+  struct TupleSize;
+
+  template<typename... Types>
+  struct TupleSize<Tuple<Types...>> : std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+  template<typename TupleType>
+  inline constexpr std::size_t TupleSize_v = TupleSize<TupleType>::value;
+
+  /**
+   * A tuple is compared by its bytes if all its elements are (and it has no padding, checked by `equals_impl`).
+   */
+  template<typename... Types>
+  struct is_bitwise_comparable<Tuple<Types...>>
+    : std::bool_constant<(is_bitwise_comparable_v<Types> && ...) && std::has_unique_object_representations_v<Tuple<Types...>>> {};
+
   /**
    * Use the perfect forwarding to avoid
    * @tparam Types the types inside the tuple
@@ -432,8 +772,88 @@ namespace tpl {
     return Tuple<std::decay_t<Types>...>(std::forward<Types>(args)...);
   }
 
+  /**
+   * Same as `tpl::makeTuple` but each element using an allocator of type `Alloc` is constructed with `alloc`
+   * (named after `std::allocate_shared`).
+   * The operators of `tpl::Tuple` do not take an allocator: the result of `operator+` contains what the `operator+`
+   * of the elements gives (for `std::pmr::string`, a string using the default memory resource), and `operator|`
+   * copies the elements with their copy constructor. Use `tpl::allocatePlus` and `tpl::allocateConcat` to place
+   * the result of these operations with `alloc`.
+   * @tparam Alloc the type of the allocator
+   * @tparam Types the types inside the tuple
+   * @param alloc the allocator given to the elements using it
+   * @param args the values to put insides of the tuple
+   * @return a tuple made with the given values
+   */
+  template <class Alloc, class... Types>
+  Tuple<std::decay_t<Types>...> allocateTuple(const Alloc& alloc, Types&&... args) {
+    return Tuple<std::decay_t<Types>...>(std::allocator_arg, alloc, std::forward<Types>(args)...);
+  }
+
+  template <class Alloc, class... LTypes, class... RTypes, std::size_t... Idx>
+  auto allocate_plus_impl(const Alloc& alloc, const Tuple<LTypes...>& lhs, const Tuple<RTypes...>& rhs, std::index_sequence<Idx...>) {
+    using Result = decltype(lhs + rhs);
+    Result result(std::allocator_arg, alloc);
+    ([&] {
+      auto& element = result.template get<Idx>();
+      if constexpr (std::uses_allocator_v<std::decay_t<decltype(element)>, Alloc>) {
+        element = lhs.template get<Idx>();
+        element += rhs.template get<Idx>();
+      } else {
+        element = lhs.template get<Idx>() + rhs.template get<Idx>();
+      }
+    }(), ...);
+    return result;
+  }
+
+  /**
+   * Same as `lhs + rhs` but each element of the result using an allocator of type `Alloc` is constructed with `alloc`:
+   * it is default constructed with `alloc`, assigned with the element of `lhs` (the allocator is kept by the assignment
+   * for `std::pmr` types) and then the element of `rhs` is added with `operator+=`.
+   * So these elements must be default constructible with an allocator and have an `operator+=` equivalent to their `operator+`.
+   * @tparam Alloc the type of the allocator
+   * @tparam LTypes the types of the elements of `lhs`
+   * @tparam RTypes the types of the elements of `rhs`
+   * @param alloc the allocator given to the elements using it
+   * @param lhs the left tuple
+   * @param rhs the right tuple
+   * @return a new tuple containing the sum of the two tuples
+   */
+  template <class Alloc, class... LTypes, class... RTypes>
+  auto allocatePlus(const Alloc& alloc, const Tuple<LTypes...>& lhs, const Tuple<RTypes...>& rhs) {
+    return allocate_plus_impl(alloc, lhs, rhs, std::make_index_sequence<sizeof...(LTypes)>{});
+  }
+
+  template <class Alloc, class... LTypes, class... RTypes, std::size_t... IL, std::size_t... IR>
+  Tuple<LTypes..., RTypes...> allocate_concat_impl(const Alloc& alloc, const Tuple<LTypes...>& lhs, const Tuple<RTypes...>& rhs,
+                                                   std::index_sequence<IL...>, std::index_sequence<IR...>) {
+    return Tuple<LTypes..., RTypes...>(std::allocator_arg, alloc, lhs.template get<IL>()..., rhs.template get<IR>()...);
+  }
+
+  /**
+   * Same as `lhs | rhs` but the elements are copied with `alloc` (see `tpl::allocateTuple`), and `lhs` and `rhs` are not modified.
+   * @tparam Alloc the type of the allocator
+   * @tparam LTypes the types of the elements of `lhs`
+   * @tparam RTypes the types of the elements of `rhs`
+   * @param alloc the allocator given to the elements using it
+   * @param lhs the left tuple
+   * @param rhs the right tuple
+   * @return a new tuple containing the concatenation of the two tuples
+   */
+  template <class Alloc, class... LTypes, class... RTypes>
+  Tuple<LTypes..., RTypes...> allocateConcat(const Alloc& alloc, const Tuple<LTypes...>& lhs, const Tuple<RTypes...>& rhs) {
+    return allocate_concat_impl(alloc, lhs, rhs, std::make_index_sequence<sizeof...(LTypes)>{}, std::make_index_sequence<sizeof...(RTypes)>{});
+  }
 
+}
 
+/**
+ * Like `std::tuple`, a `tpl::Tuple` accepts any allocator, so the containers using an allocator (`std::pmr::vector`, ...)
+ * give it to the tuples they contain.
+ */
+namespace std {
+  template<typename... Types, typename Alloc>
+  struct uses_allocator<tpl::Tuple<Types...>, Alloc> : true_type {};
 }
 
 #endif // T_TUPLE_H
@@ -0,0 +1,401 @@
+#ifndef T_TUPLE_CONCURRENT_H
+#define T_TUPLE_CONCURRENT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace tpl {
+  /**
+   * Size of a cache line, used to align the slots and the indexes of the queues to avoid false sharing.
+   */
+  inline constexpr std::size_t cache_line_size = 64;
+
+  /**
+   * Lock-free ring buffer with a single producer and a single consumer.
+   * Each element is stored in its own cache line, and the two indexes are in separate cache lines,
+   * so the producer and the consumer do not write in the same cache line.
+   * @tparam T the type of the elements (typically a small `tpl::Tuple`)
+   * @tparam Capacity the maximum number of elements, must be a power of two
+   */
+  template<typename T, std::size_t Capacity>
+  class SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity of a SpscRing must be a power of two");
+
+  public:
+    /**
+     * Must only be called by the producer thread.
+     * @param value the element to add
+     * @return false if the ring is full, true otherwise
+     */
+    bool try_push(const T& value) {
+      const std::size_t tail = write_idx.load(std::memory_order_relaxed);
+      if (tail - read_idx.load(std::memory_order_acquire) == Capacity)
+        return false;
+      slots[tail & (Capacity - 1)].value = value;
+      write_idx.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Must only be called by the consumer thread.
+     * @param out where the oldest element is copied
+     * @return false if the ring is empty, true otherwise
+     */
+    bool try_pop(T& out) {
+      const std::size_t head = read_idx.load(std::memory_order_relaxed);
+      if (head == write_idx.load(std::memory_order_acquire))
+        return false;
+      out = slots[head & (Capacity - 1)].value;
+      read_idx.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    struct alignas(cache_line_size) Slot {
+      T value;
+    };
+
+    Slot slots[Capacity];
+    alignas(cache_line_size) std::atomic<std::size_t> read_idx{0};
+    alignas(cache_line_size) std::atomic<std::size_t> write_idx{0};
+  };
+
+  /**
+   * Bounded lock-free queue with multiple producers and multiple consumers
+   * (Dmitry Vyukov's algorithm, cf <a href="https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue">1024cores.net/...</a>).
+   * Each slot holds a sequence number telling if it is ready to be written or read for a given turn,
+   * so a producer and a consumer only compete on the index they increment.
+   * @tparam T the type of the elements (typically a small `tpl::Tuple`)
+   * @tparam Capacity the maximum number of elements, must be a power of two greater than 1
+   */
+  template<typename T, std::size_t Capacity>
+  class MpmcQueue {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "The capacity of a MpmcQueue must be a power of two greater than 1");
+
+  public:
+    MpmcQueue() {
+      for (std::size_t i = 0; i < Capacity; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @param value the element to add
+     * @return false if the queue is full, true otherwise
+     */
+    bool try_push(const T& value) {
+      std::size_t pos = enqueue_idx.load(std::memory_order_relaxed);
+      Slot* slot;
+      for (;;) {
+        slot = &slots[pos & (Capacity - 1)];
+        const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+          if (enqueue_idx.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        } else if (diff < 0) {
+          return false;
+        } else {
+          pos = enqueue_idx.load(std::memory_order_relaxed);
+        }
+      }
+      slot->value = value;
+      slot->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @param out where the oldest element is copied
+     * @return false if the queue is empty, true otherwise
+     */
+    bool try_pop(T& out) {
+      std::size_t pos = dequeue_idx.load(std::memory_order_relaxed);
+      Slot* slot;
+      for (;;) {
+        slot = &slots[pos & (Capacity - 1)];
+        const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+        if (diff == 0) {
+          if (dequeue_idx.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        } else if (diff < 0) {
+          return false;
+        } else {
+          pos = dequeue_idx.load(std::memory_order_relaxed);
+        }
+      }
+      out = slot->value;
+      slot->sequence.store(pos + Capacity, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    struct alignas(cache_line_size) Slot {
+      std::atomic<std::size_t> sequence;
+      T value;
+    };
+
+    Slot slots[Capacity];
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_idx{0};
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_idx{0};
+  };
+
+  /**
+   * Storage of a `tpl::AtomicTuple` for the types fitting in 8 bytes: the value is copied in a `std::atomic<std::uint64_t>`.
+   * @tparam T the type of the value
+   */
+  template<typename T>
+  class AtomicTuple_Word {
+  public:
+    static constexpr bool is_lock_free = true;
+
+    explicit AtomicTuple_Word(const T& value) : word(to_word(value)) {}
+
+    T load() const { return from_word(word.load(std::memory_order_acquire)); }
+
+    void store(const T& value) { word.store(to_word(value), std::memory_order_release); }
+
+    /**
+     * @tparam Func the type of the function
+     * @param func a function modifying the copy of the value it receives
+     * @return the value before the modification
+     */
+    template<typename Func>
+    T update(Func func) {
+      std::uint64_t expected = word.load(std::memory_order_relaxed);
+      for (;;) {
+        T value = from_word(expected);
+        func(value);
+        if (word.compare_exchange_weak(expected, to_word(value), std::memory_order_acq_rel, std::memory_order_relaxed))
+          return from_word(expected);
+      }
+    }
+
+  private:
+    static std::uint64_t to_word(const T& value) {
+      std::uint64_t w = 0;
+      std::memcpy(&w, &value, sizeof(T));
+      return w;
+    }
+
+    static T from_word(const std::uint64_t w) {
+      T value;
+      std::memcpy(static_cast<void*>(&value), &w, sizeof(T));
+      return value;
+    }
+
+    std::atomic<std::uint64_t> word;
+  };
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+  /**
+   * Storage of a `tpl::AtomicTuple` for the types fitting in 16 bytes: the value is copied in a 16 bytes word
+   * accessed with the double-width compare-and-swap of the processor (`cmpxchg16b` on x86-64, enabled by `-mcx16`).
+   * The builtins `__sync_*` are used because the `__atomic_*` ones call libatomic for 16 bytes.
+   * @tparam T the type of the value
+   */
+  template<typename T>
+  class AtomicTuple_DoubleWord {
+  public:
+    static constexpr bool is_lock_free = true;
+
+    explicit AtomicTuple_DoubleWord(const T& value) : word(to_word(value)) {}
+
+    /**
+     * A compare-and-swap with the same expected and desired values returns the current value without modifying it.
+     */
+    T load() const { return from_word(__sync_val_compare_and_swap(&word, Word{0}, Word{0})); }
+
+    void store(const T& value) {
+      update([&value](T& current) { current = value; });
+    }
+
+    /**
+     * @tparam Func the type of the function
+     * @param func a function modifying the copy of the value it receives
+     * @return the value before the modification
+     */
+    template<typename Func>
+    T update(Func func) {
+      Word expected = __sync_val_compare_and_swap(&word, Word{0}, Word{0});
+      for (;;) {
+        T value = from_word(expected);
+        func(value);
+        const Word previous = __sync_val_compare_and_swap(&word, expected, to_word(value));
+        if (previous == expected)
+          return from_word(previous);
+        expected = previous;
+      }
+    }
+
+  private:
+    using Word = unsigned __int128;
+
+    static Word to_word(const T& value) {
+      Word w = 0;
+      std::memcpy(&w, &value, sizeof(T));
+      return w;
+    }
+
+    static T from_word(const Word w) {
+      T value;
+      std::memcpy(static_cast<void*>(&value), &w, sizeof(T));
+      return value;
+    }
+
+    alignas(16) mutable Word word;
+  };
+#endif
+
+  /**
+   * Storage of a `tpl::AtomicTuple` for the bigger types: a sequence lock (seqlock).
+   * The writers increment the sequence before and after modifying the value (odd while writing),
+   * the readers copy the value and retry if the sequence changed meanwhile, so they never block the writers.
+   * The value is stored in relaxed atomic words so that the concurrent copies are not data races.
+   * @tparam T the type of the value
+   */
+  template<typename T>
+  class AtomicTuple_SeqLock {
+  public:
+    static constexpr bool is_lock_free = false;
+
+    explicit AtomicTuple_SeqLock(const T& value) { write(value); }
+
+    T load() const {
+      std::uint64_t buffer[Words];
+      for (;;) {
+        const std::size_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1)
+          continue;
+        for (std::size_t i = 0; i < Words; ++i)
+          buffer[i] = words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+          T value;
+          std::memcpy(static_cast<void*>(&value), buffer, sizeof(T));
+          return value;
+        }
+      }
+    }
+
+    void store(const T& value) {
+      update([&value](T& current) { current = value; });
+    }
+
+    /**
+     * @tparam Func the type of the function
+     * @param func a function modifying the copy of the value it receives
+     * @return the value before the modification
+     */
+    template<typename Func>
+    T update(Func func) {
+      std::size_t seq = sequence.load(std::memory_order_relaxed);
+      while ((seq & 1) || !sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        seq = sequence.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      T previous = read();
+      T value = previous;
+      func(value);
+      write(value);
+
+      sequence.store(seq + 2, std::memory_order_release);
+      return previous;
+    }
+
+  private:
+    static constexpr std::size_t Words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    /**
+     * Only called by the writer holding the lock (or the constructor).
+     */
+    T read() const {
+      std::uint64_t buffer[Words];
+      for (std::size_t i = 0; i < Words; ++i)
+        buffer[i] = words[i].load(std::memory_order_relaxed);
+      T value;
+      std::memcpy(static_cast<void*>(&value), buffer, sizeof(T));
+      return value;
+    }
+
+    /**
+     * Only called by the writer holding the lock (or the constructor).
+     */
+    void write(const T& value) {
+      std::uint64_t buffer[Words] = {};
+      std::memcpy(buffer, &value, sizeof(T));
+      for (std::size_t i = 0; i < Words; ++i)
+        words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<std::size_t> sequence{0};
+    std::atomic<std::uint64_t> words[Words];
+  };
+
+  /**
+   * Select the storage of a `tpl::AtomicTuple` according to the size of `T`.
+   */
+  template<typename T>
+  using AtomicTuple_Storage =
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    std::conditional_t<(sizeof(T) <= 8), AtomicTuple_Word<T>,
+    std::conditional_t<(sizeof(T) <= 16), AtomicTuple_DoubleWord<T>,
+                                          AtomicTuple_SeqLock<T>>>;
+#else
+    std::conditional_t<(sizeof(T) <= 8), AtomicTuple_Word<T>,
+                                          AtomicTuple_SeqLock<T>>;
+#endif
+
+  /**
+   * Atomic cell for a trivially copyable value, typically a small `tpl::Tuple`.
+   * The value is lock-free if it fits in 8 bytes, or in 16 bytes when the processor has a double-width compare-and-swap,
+   * else a sequence lock is used (see `tpl::AtomicTuple_Storage`).
+   * @tparam T the type of the value
+   */
+  template<typename T>
+  class AtomicTuple : AtomicTuple_Storage<T> {
+    static_assert(std::is_trivially_copyable_v<T>, "An AtomicTuple can only contain a trivially copyable type");
+    static_assert(std::is_default_constructible_v<T>, "An AtomicTuple can only contain a default constructible type");
+
+    using Storage = AtomicTuple_Storage<T>;
+
+  public:
+    static constexpr bool is_always_lock_free = Storage::is_lock_free;
+
+    AtomicTuple() : Storage(T()) {}
+
+    explicit AtomicTuple(const T& value) : Storage(value) {}
+
+    AtomicTuple(const AtomicTuple&) = delete;
+    AtomicTuple& operator=(const AtomicTuple&) = delete;
+
+    using Storage::load;
+    using Storage::store;
+
+    /**
+     * @param value the new value
+     * @return the previous value
+     */
+    T exchange(const T& value) {
+      return Storage::update([&value](T& current) { current = value; });
+    }
+
+    /**
+     * Atomically add `delta` to the value with its `operator+=`.
+     * @tparam Delta the type of the value to add (for a `tpl::Tuple`, any tuple of the same size)
+     * @param delta the value to add
+     * @return the previous value
+     */
+    template<typename Delta>
+    T fetch_add(const Delta& delta) {
+      return Storage::update([&delta](T& current) { current += delta; });
+    }
+  };
+}
+
+#endif // T_TUPLE_CONCURRENT_H
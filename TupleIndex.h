@@ -0,0 +1,258 @@
+#ifndef T_TUPLE_INDEX_H
+#define T_TUPLE_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Tuple.h"
+#include "TupleConcurrent.h"
+
+namespace tpl {
+  /**
+   * Ask the processor to load the cache line containing `address` before it is used.
+   * @param address the address to load
+   */
+  inline void prefetch([[maybe_unused]] const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+  }
+
+  /**
+   * Compare the first `K` elements of `row` with `prefix` lexicographically, `K` being the size of `prefix`
+   * (see `tpl::Tuple::lexic_compare`).
+   * @tparam I the index of the element to compare
+   * @tparam Row the type of the row
+   * @tparam Prefix the type of the prefix, a `tpl::Tuple` with at most as many elements as `Row`
+   * @param row the row
+   * @param prefix the prefix
+   * @return -1 if the prefix of `row` is less than `prefix`, 1 if it is greater, 0 if they are equal
+   */
+  template<std::size_t I = 0, typename Row, typename Prefix>
+  int compare_prefix(const Row& row, const Prefix& prefix) {
+    if constexpr (I < TupleSize_v<Prefix>) {
+      if (row.template get<I>() < prefix.template get<I>())
+        return -1;
+      if (prefix.template get<I>() < row.template get<I>())
+        return 1;
+      return compare_prefix<I + 1>(row, prefix);
+    } else {
+      return 0;
+    }
+  }
+
+  /**
+   * Sorted and immutable set of tuples, searchable by the first K elements (a prefix).
+   * The tuples are stored only once, in the Eytzinger layout (the order of a breadth-first traversal of the binary search tree:
+   * the children of the node `k` are at `2k` and `2k + 1`), so the first levels of every search are in the same cache lines,
+   * and the nodes visited 4 levels later, which are contiguous, can be prefetched.
+   * Two arrays give the index in the sorted order of each node and the node of each index, so the index uses
+   * two `std::size_t` per tuple in addition to the tuples, and its iterators visit the tuples in sorted order.
+   * The elements are only compared with `operator<`, so the index does not know their type: the string columns are not
+   * prefix-compressed, and there is no interpolation search (it needs to compute a distance between two keys).
+   * @tparam TupleType the type of the tuples
+   */
+  template<typename TupleType>
+  class TupleIndex {
+  public:
+    /**
+     * Random access iterator on the tuples in sorted order.
+     */
+    class const_iterator {
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = TupleType;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const TupleType*;
+      using reference = const TupleType&;
+
+      const_iterator() = default;
+      const_iterator(const TupleIndex* index, const std::size_t rank) : index(index), rank(rank) {}
+
+      reference operator*() const { return (*index)[rank]; }
+      pointer operator->() const { return &(*index)[rank]; }
+      reference operator[](const difference_type n) const { return *(*this + n); }
+
+      const_iterator& operator++() { ++rank; return *this; }
+      const_iterator operator++(int) { const_iterator it = *this; ++rank; return it; }
+      const_iterator& operator--() { --rank; return *this; }
+      const_iterator operator--(int) { const_iterator it = *this; --rank; return it; }
+
+      const_iterator& operator+=(const difference_type n) { rank = static_cast<std::size_t>(static_cast<difference_type>(rank) + n); return *this; }
+      const_iterator& operator-=(const difference_type n) { return *this += -n; }
+      const_iterator operator+(const difference_type n) const { const_iterator it = *this; return it += n; }
+      const_iterator operator-(const difference_type n) const { const_iterator it = *this; return it -= n; }
+      friend const_iterator operator+(const difference_type n, const const_iterator& it) { return it + n; }
+      difference_type operator-(const const_iterator& other) const {
+        return static_cast<difference_type>(rank) - static_cast<difference_type>(other.rank);
+      }
+
+      bool operator==(const const_iterator& other) const { return rank == other.rank; }
+      bool operator!=(const const_iterator& other) const { return rank != other.rank; }
+      bool operator<(const const_iterator& other) const { return rank < other.rank; }
+      bool operator>(const const_iterator& other) const { return rank > other.rank; }
+      bool operator<=(const const_iterator& other) const { return rank <= other.rank; }
+      bool operator>=(const const_iterator& other) const { return rank >= other.rank; }
+
+    private:
+      const TupleIndex* index = nullptr;
+      std::size_t rank = 0;
+    };
+
+    /**
+     * @param rows the tuples to index, they are sorted with `operator<`
+     */
+    explicit TupleIndex(std::vector<TupleType> rows) : tree(rows.size() + 1), ranks(rows.size() + 1), nodes(rows.size()) {
+      std::sort(rows.begin(), rows.end());
+      ranks[0] = rows.size();
+      std::size_t i = 0;
+      build(rows, i, 1);
+    }
+
+    std::size_t size() const { return nodes.size(); }
+
+    /**
+     * @param idx the index in the sorted order
+     * @return the tuple at this index
+     */
+    const TupleType& operator[](const std::size_t idx) const { return tree[nodes[idx]]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    /**
+     * @tparam Prefix the type of the prefix, a `tpl::Tuple` with at most as many elements as `TupleType`
+     * @param prefix the values of the first elements
+     * @return the index (in the sorted order) of the first tuple whose prefix is not less than `prefix`, `size()` if there is none
+     */
+    template<typename Prefix>
+    std::size_t lowerBound(const Prefix& prefix) const {
+      return search([&prefix](const TupleType& node) { return compare_prefix(node, prefix) < 0; });
+    }
+
+    /**
+     * @tparam Prefix the type of the prefix, a `tpl::Tuple` with at most as many elements as `TupleType`
+     * @param prefix the values of the first elements
+     * @return the index (in the sorted order) of the first tuple whose prefix is greater than `prefix`, `size()` if there is none
+     */
+    template<typename Prefix>
+    std::size_t upperBound(const Prefix& prefix) const {
+      return search([&prefix](const TupleType& node) { return compare_prefix(node, prefix) <= 0; });
+    }
+
+    /**
+     * @tparam Prefix the type of the prefix, a `tpl::Tuple` with at most as many elements as `TupleType`
+     * @param prefix the values of the first elements
+     * @return the range of the tuples starting with `prefix`
+     */
+    template<typename Prefix>
+    std::pair<const_iterator, const_iterator> equalRange(const Prefix& prefix) const {
+      return {const_iterator(this, lowerBound(prefix)), const_iterator(this, upperBound(prefix))};
+    }
+
+    /**
+     * Same as calling `lowerBound` for each prefix, but the searches are done by groups of `Group` at the same time,
+     * one level of each search after another: the loads of the nodes of a group are independent,
+     * so the processor waits for the memory once per level of the group instead of once per level of each search.
+     * @tparam Prefix the type of the prefixes
+     * @param prefixes the prefixes to search
+     * @return the result of `lowerBound` for each prefix
+     */
+    template<typename Prefix>
+    std::vector<std::size_t> lowerBounds(const std::vector<Prefix>& prefixes) const {
+      constexpr std::size_t Group = 16;
+      const std::size_t n = size();
+      std::vector<std::size_t> result(prefixes.size());
+
+      for (std::size_t first = 0; first < prefixes.size(); first += Group) {
+        const std::size_t count = std::min(Group, prefixes.size() - first);
+        std::size_t nodes_of_group[Group];
+        std::fill(nodes_of_group, nodes_of_group + count, 1);
+
+        for (bool searching = n > 0; searching;) {
+          searching = false;
+          for (std::size_t i = 0; i < count; ++i) {
+            std::size_t& k = nodes_of_group[i];
+            if (k <= n) {
+              k = 2 * k + (compare_prefix(tree[k], prefixes[first + i]) < 0);
+              if (k <= n)
+                prefetch(&tree[k]);
+              searching = true;
+            }
+          }
+        }
+
+        // The ranks of the found nodes are also loaded at the same time.
+        for (std::size_t i = 0; i < count; ++i) {
+          nodes_of_group[i] = found_node(nodes_of_group[i]);
+          prefetch(&ranks[nodes_of_group[i]]);
+        }
+        for (std::size_t i = 0; i < count; ++i)
+          result[first + i] = ranks[nodes_of_group[i]];
+      }
+      return result;
+    }
+
+  private:
+    /**
+     * Fill the tree by an in-order traversal, which visits the nodes in the sorted order.
+     * @param rows the sorted tuples, moved to the tree
+     * @param i the index of the next tuple of `rows` to put in the tree
+     * @param k the node to fill
+     */
+    void build(std::vector<TupleType>& rows, std::size_t& i, const std::size_t k) {
+      if (k < tree.size()) {
+        build(rows, i, 2 * k);
+        tree[k] = std::move(rows[i]);
+        ranks[k] = i;
+        nodes[i++] = k;
+        build(rows, i, 2 * k + 1);
+      }
+    }
+
+    /**
+     * Go down the tree to the right while `go_right` is true for the node, to the left otherwise,
+     * the searched node being the last one from which we went to the left.
+     * The 16 descendants 4 levels below are prefetched, one cache line at a time.
+     * @tparam GoRight the type of the predicate
+     * @param go_right true if the searched tuple is after the node
+     * @return the index of the searched tuple in the sorted order
+     */
+    template<typename GoRight>
+    std::size_t search(GoRight go_right) const {
+      const std::size_t n = size();
+      std::size_t k = 1;
+      while (k <= n) {
+        if (16 * k <= n) {
+          const char* line = reinterpret_cast<const char*>(&tree[16 * k]);
+          const char* last = reinterpret_cast<const char*>(tree.data() + std::min(16 * k + 16, n + 1));
+          for (; line < last; line += cache_line_size)
+            prefetch(line);
+        }
+        k = 2 * k + go_right(tree[k]);
+      }
+      return ranks[found_node(k)];
+    }
+
+    /**
+     * The path to the node `k` is given by its bits (1 for the right), so removing the trailing ones (the last moves to the right)
+     * and the last move to the left gives the searched node.
+     * @param k the node where the search left the tree
+     * @return the searched node, 0 if there is none (its rank is then `size()`)
+     */
+    static std::size_t found_node(std::size_t k) {
+      while (k & 1)
+        k >>= 1;
+      return k >> 1;
+    }
+
+    std::vector<TupleType> tree;
+    std::vector<std::size_t> ranks;
+    std::vector<std::size_t> nodes;
+  };
+}
+
+#endif // T_TUPLE_INDEX_H
@@ -0,0 +1,276 @@
+#ifndef T_TUPLE_PARALLEL_H
+#define T_TUPLE_PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Tuple.h"
+#include "TupleConcurrent.h"
+
+namespace tpl {
+  /**
+   * Number of threads used by default by the parallel algorithms (at least 1).
+   */
+  inline unsigned default_thread_count() {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  /**
+   * Split `[first, last)` in `threads` contiguous chunks and call `func(chunk_index, chunk_first, chunk_last)` for each of them in its own thread.
+   * @tparam Iterator the type of the iterators of the range
+   * @tparam Func the type of the function
+   * @param first the beginning of the range
+   * @param last the end of the range
+   * @param threads the number of chunks (and of threads)
+   * @param func the function called for each chunk
+   */
+  template<typename Iterator, typename Func>
+  void for_each_chunk(Iterator first, Iterator last, const unsigned threads, Func func) {
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+      const Iterator chunk_first = std::next(first, static_cast<std::ptrdiff_t>(size * i / threads));
+      const Iterator chunk_last = std::next(first, static_cast<std::ptrdiff_t>(size * (i + 1) / threads));
+      workers.emplace_back(func, i, chunk_first, chunk_last);
+    }
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  /**
+   * Threads created once and reused for several parallel tasks, to avoid creating and joining threads for each task
+   * as `tpl::for_each_chunk` does.
+   */
+  class WorkerPool {
+  public:
+    /**
+     * @param threads the number of threads (0 is handled as 1)
+     */
+    explicit WorkerPool(const unsigned threads) {
+      const unsigned count = std::max(1u, threads);
+      workers.reserve(count);
+      for (unsigned i = 0; i < count; ++i)
+        workers.emplace_back([this, i] { work(i); });
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+      {
+        const std::lock_guard lock(mutex);
+        stopping = true;
+      }
+      start.notify_all();
+      for (auto& worker : workers)
+        worker.join();
+    }
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    /**
+     * Call `func(worker_index)` once in each thread of the pool and wait until all the calls are done.
+     * @param func the function to call, it must be callable from several threads at the same time
+     */
+    void run(std::function<void(unsigned)> func) {
+      {
+        const std::lock_guard lock(mutex);
+        task = std::move(func);
+        remaining = size();
+        ++generation;
+      }
+      start.notify_all();
+      std::unique_lock lock(mutex);
+      done.wait(lock, [this] { return remaining == 0; });
+    }
+
+  private:
+    void work(const unsigned idx) {
+      std::size_t seen = 0;
+      for (;;) {
+        std::unique_lock lock(mutex);
+        start.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if (stopping)
+          return;
+        seen = generation;
+        lock.unlock();
+
+        task(idx);
+
+        lock.lock();
+        if (--remaining == 0)
+          done.notify_one();
+      }
+    }
+
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+    std::function<void(unsigned)> task;
+    std::size_t generation = 0;
+    unsigned remaining = 0;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+  };
+
+  /**
+   * Value padded to a whole cache line, so that the partial results of two threads are never in the same cache line (false sharing).
+   * @tparam T the type of the value
+   */
+  template<typename T>
+  struct alignas(cache_line_size) Padded {
+    T value;
+  };
+
+  template<typename T>
+  struct is_tuple : std::false_type {};
+
+  template<typename... Types>
+  struct is_tuple<Tuple<Types...>> : std::true_type {};
+
+  template<typename T, typename Value, std::size_t... Idx>
+  T convert_impl(const Value& value, std::index_sequence<Idx...>) {
+    return T(static_cast<std::decay_t<decltype(std::declval<T&>().template get<Idx>())>>(value.template get<Idx>())...);
+  }
+
+  /**
+   * Convert `value` to the type `T`, element by element if both are a `tpl::Tuple` (of the same size).
+   * @tparam T the type of the result
+   * @tparam Value the type of the value
+   * @param value the value to convert
+   * @return the converted value
+   */
+  template<typename T, typename Value>
+  T convert(const Value& value) {
+    if constexpr (std::is_same_v<T, Value>) {
+      return value;
+    } else if constexpr (is_tuple<T>::value && is_tuple<Value>::value) {
+      return convert_impl<T>(value, std::make_index_sequence<TupleSize_v<T>>{});
+    } else {
+      return static_cast<T>(value);
+    }
+  }
+
+  /**
+   * Sum all the elements of `range` to `init` with `operator+=`, using `threads` threads.
+   * Each thread accumulates its chunk in its own partial result of type `T`, starting from the first element of the chunk
+   * converted to `T` (see `tpl::convert`), then the partial results are added to `init` in order.
+   * So, as in the sequential sum, the elements are accumulated in `T` (a `tpl::Tuple<long long>` does not overflow
+   * when summing `tpl::Tuple<int>`), and the result is the same if the `operator+=` of `T` is associative.
+   * @tparam Range the type of the range (`std::vector<tpl::Tuple<...>>`, ...)
+   * @tparam T the type of the result (for a `tpl::Tuple`, any tuple of the same size as the elements)
+   * @param range the elements to sum
+   * @param init the initial value of the sum
+   * @param threads the number of threads (0 is handled as 1)
+   * @return the sum of `init` and of all the elements of `range`
+   */
+  template<typename Range, typename T>
+  T parallel_reduce(const Range& range, T init, unsigned threads = default_thread_count()) {
+    threads = std::max(1u, threads);
+
+    std::vector<Padded<std::optional<T>>> partials(threads);
+    for_each_chunk(std::begin(range), std::end(range), threads, [&partials](const unsigned idx, auto first, const auto last) {
+      if (first == last)
+        return;
+      T partial = convert<T>(*first);
+      for (++first; first != last; ++first)
+        partial += *first;
+      partials[idx].value = std::move(partial);
+    });
+
+    for (const auto& partial : partials) {
+      if (partial.value)
+        init += *partial.value;
+    }
+    return init;
+  }
+
+  /**
+   * @tparam Idx A `std:size_t...`. The indexes of the elements to keep.
+   * @tparam TupleType the type of the tuple
+   * @param t the tuple
+   * @return a new tuple containing the elements of `t` at the given indexes
+   */
+  template<std::size_t... Idx, typename TupleType>
+  auto select(const TupleType& t, std::index_sequence<Idx...>) {
+    return makeTuple(t.template get<Idx>()...);
+  }
+
+  template<std::size_t... Idx>
+  constexpr auto concat_sequences(std::index_sequence<Idx...>) {
+    return std::index_sequence<Idx...>{};
+  }
+
+  /**
+   * @return a `std::index_sequence` containing the indexes of all the given sequences
+   */
+  template<std::size_t... IL, std::size_t... IR, typename... Rest>
+  constexpr auto concat_sequences(std::index_sequence<IL...>, std::index_sequence<IR...>, Rest... rest) {
+    return concat_sequences(std::index_sequence<IL..., IR...>{}, rest...);
+  }
+
+  template<std::size_t I, std::size_t... Idx>
+  inline constexpr bool is_one_of_v = ((I == Idx) || ...);
+
+  /**
+   * @tparam KeyIdx the indexes of the keys
+   * @tparam Idx A `std:size_t...`. All the indexes of the tuple.
+   * @return a `std::index_sequence` containing the indexes of `Idx` which are not in `KeyIdx`
+   */
+  template<std::size_t... KeyIdx, std::size_t... Idx>
+  constexpr auto remove_indexes(std::index_sequence<Idx...>) {
+    return concat_sequences(std::index_sequence<>{},
+      std::conditional_t<is_one_of_v<Idx, KeyIdx...>, std::index_sequence<>, std::index_sequence<Idx>>{}...
+    );
+  }
+
+  /**
+   * Group the elements of `range` by the elements at the indexes `KeyIdx...` and sum the remaining elements of each group with `operator+=`.
+   * Each thread groups its chunk in its own map, then the maps are merged.
+   * For example, `group_by<0>` on `{(1, 2, 0.5), (2, 1, 1.0), (1, 3, 1.0)}` gives `{(1) : (5, 1.5), (2) : (1, 1.0)}`.
+   * @tparam KeyIdx the indexes of the keys
+   * @tparam Range the type of the range (`std::vector<tpl::Tuple<...>>`, ...)
+   * @param range the elements to group
+   * @param threads the number of threads (0 is handled as 1)
+   * @return a map associating the tuple of the keys to the sum of the tuples of the remaining elements
+   */
+  template<std::size_t... KeyIdx, typename Range>
+  auto group_by(const Range& range, unsigned threads = default_thread_count()) {
+    threads = std::max(1u, threads);
+    using Value = std::decay_t<decltype(*std::begin(range))>;
+    using KeyIndexes = std::index_sequence<KeyIdx...>;
+    using ValueIndexes = decltype(remove_indexes<KeyIdx...>(std::make_index_sequence<TupleSize_v<Value>>{}));
+    using Map = std::map<decltype(select(std::declval<Value>(), KeyIndexes{})), decltype(select(std::declval<Value>(), ValueIndexes{}))>;
+
+    const auto add = [](Map& map, auto&& key, auto&& value) {
+      const auto [it, inserted] = map.try_emplace(std::forward<decltype(key)>(key), value);
+      if (!inserted)
+        it->second += value;
+    };
+
+    std::vector<Padded<Map>> partials(threads);
+    for_each_chunk(std::begin(range), std::end(range), threads, [&partials, &add](const unsigned idx, auto first, const auto last) {
+      for (; first != last; ++first)
+        add(partials[idx].value, select(*first, KeyIndexes{}), select(*first, ValueIndexes{}));
+    });
+
+    Map result = std::move(partials[0].value);
+    for (unsigned i = 1; i < threads; ++i) {
+      for (const auto& [key, value] : partials[i].value)
+        add(result, key, value);
+    }
+    return result;
+  }
+}
+
+#endif // T_TUPLE_PARALLEL_H
@@ -0,0 +1,238 @@
+#ifndef T_TUPLE_STREAM_H
+#define T_TUPLE_STREAM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Tuple.h"
+#include "TupleParallel.h"
+
+namespace tpl {
+  /**
+   * Lazy pull-based stream: each stage asks the previous one for the next element only when it needs it,
+   * so the elements flow through a chain of stages (`map`, `filter`, ...) without being stored between them.
+   * The project is compiled in C++17, so the stages are lambdas nested in each other instead of coroutines.
+   * The stages consume the stream (`std::move(s).map(...)`, or directly on a temporary).
+   * @tparam Source the type of a callable returning the next element as a `std::optional` (`std::nullopt` at the end of the stream)
+   */
+  template<typename Source>
+  class Stream {
+  public:
+    using value_type = typename std::invoke_result_t<Source&>::value_type;
+
+    explicit Stream(Source source) : source(std::move(source)) {}
+
+    /**
+     * @return the next element, or `std::nullopt` at the end of the stream
+     */
+    std::optional<value_type> next() { return source(); }
+
+    /**
+     * @tparam Func the type of the function
+     * @param func the function applied to each element
+     * @return a stream of the results of `func`
+     */
+    template<typename Func>
+    auto map(Func func) && {
+      using Result = std::decay_t<std::invoke_result_t<Func&, value_type&&>>;
+      return makeStream([src = std::move(source), func]() mutable -> std::optional<Result> {
+        auto value = src();
+        if (!value)
+          return std::nullopt;
+        return func(std::move(*value));
+      });
+    }
+
+    /**
+     * @tparam Pred the type of the predicate
+     * @param pred the predicate, for example a comparison of tuples
+     * @return a stream of the elements for which `pred` is true
+     */
+    template<typename Pred>
+    auto filter(Pred pred) && {
+      return makeStream([src = std::move(source), pred]() mutable -> std::optional<value_type> {
+        for (auto value = src(); value; value = src()) {
+          if (pred(*value))
+            return value;
+        }
+        return std::nullopt;
+      });
+    }
+
+    /**
+     * Concatenate each tuple with the tuple at the same position in `other` with `tpl::Tuple::operator|`.
+     * The stream ends with the shortest of the two.
+     * @tparam OtherSource the type of the source of the other stream
+     * @param other the stream of the tuples to append
+     * @return a stream of the concatenated tuples
+     */
+    template<typename OtherSource>
+    auto concat(Stream<OtherSource> other) && {
+      using Result = decltype(std::declval<value_type>() | std::declval<typename Stream<OtherSource>::value_type>());
+      return makeStream([src = std::move(source), other = std::move(other)]() mutable -> std::optional<Result> {
+        auto lhs = src();
+        if (!lhs)
+          return std::nullopt;
+        auto rhs = other.next();
+        if (!rhs)
+          return std::nullopt;
+        return std::move(*lhs) | std::move(*rhs);
+      });
+    }
+
+    /**
+     * @param size the number of elements of each batch (0 is handled as 1)
+     * @return a stream of `std::vector` of `size` elements (the last one can be smaller)
+     */
+    auto batch(std::size_t size) && {
+      size = std::max<std::size_t>(1, size);
+      return makeStream([src = std::move(source), size]() mutable -> std::optional<std::vector<value_type>> {
+        std::vector<value_type> values;
+        values.reserve(size);
+        while (values.size() < size) {
+          auto value = src();
+          if (!value)
+            break;
+          values.push_back(std::move(*value));
+        }
+        if (values.empty())
+          return std::nullopt;
+        return values;
+      });
+    }
+
+    /**
+     * Same as `map` but `func` is applied by `threads` threads of a `tpl::WorkerPool`, created once with the stage.
+     * The elements are pulled by blocks of `threads * chunk` elements, so only one block is stored at a time,
+     * and the results keep the order of the elements.
+     * @tparam Func the type of the function, it must be callable from several threads at the same time
+     * @param threads the number of threads (0 is handled as 1)
+     * @param func the function applied to each element
+     * @param chunk the number of elements given to each thread for each block (0 is handled as 1), each block
+     * costs one synchronization of the threads, so a small `chunk` is slower
+     * @return a stream of the results of `func`
+     */
+    template<typename Func>
+    auto parallel(unsigned threads, Func func, std::size_t chunk = 1024) && {
+      using Result = std::decay_t<std::invoke_result_t<Func&, value_type&&>>;
+      threads = std::max(1u, threads);
+      chunk = std::max<std::size_t>(1, chunk);
+      const auto pool = std::make_shared<WorkerPool>(threads);
+      std::vector<std::optional<Result>> results;
+      std::size_t pos = 0;
+      return makeStream([src = std::move(source), func, pool, chunk, results, pos]() mutable -> std::optional<Result> {
+        if (pos == results.size()) {
+          const std::size_t block = pool->size() * chunk;
+          std::vector<value_type> values;
+          values.reserve(block);
+          while (values.size() < block) {
+            auto value = src();
+            if (!value)
+              break;
+            values.push_back(std::move(*value));
+          }
+          if (values.empty())
+            return std::nullopt;
+
+          results.assign(values.size(), std::nullopt);
+          const std::size_t workers = pool->size();
+          pool->run([&values, &results, &func, workers](const unsigned idx) {
+            const std::size_t last = values.size() * (idx + 1) / workers;
+            for (std::size_t i = values.size() * idx / workers; i < last; ++i)
+              results[i] = func(std::move(values[i]));
+          });
+          pos = 0;
+        }
+        return std::move(results[pos++]);
+      });
+    }
+
+    /**
+     * @tparam Func the type of the function
+     * @param func the function called for each element, in order
+     */
+    template<typename Func>
+    void forEach(Func func) && {
+      for (auto value = source(); value; value = source())
+        func(std::move(*value));
+    }
+
+    /**
+     * Input iterator, so that a stream can be used in a range-based for loop.
+     */
+    class iterator {
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = typename Stream::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = value_type*;
+      using reference = value_type&;
+
+      iterator() = default;
+      explicit iterator(Stream* stream) : stream(stream), current(stream->next()) {}
+
+      reference operator*() { return *current; }
+      pointer operator->() { return &*current; }
+
+      iterator& operator++() {
+        current = stream->next();
+        return *this;
+      }
+
+      /**
+       * Two iterators are equal when they are both at the end of the stream.
+       */
+      bool operator==(const iterator& other) const { return !current && !other.current; }
+      bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+      Stream* stream = nullptr;
+      std::optional<value_type> current;
+    };
+
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+  private:
+    template<typename OtherSource>
+    static Stream<OtherSource> makeStream(OtherSource source) {
+      return Stream<OtherSource>(std::move(source));
+    }
+
+    Source source;
+  };
+
+  /**
+   * @tparam Source the type of the callable
+   * @param source a callable returning the next element as a `std::optional`, or `std::nullopt` at the end
+   * @return a stream of the elements given by `source`
+   */
+  template<typename Source>
+  Stream<Source> generate(Source source) {
+    return Stream<Source>(std::move(source));
+  }
+
+  /**
+   * The range is not copied, it must live until the end of the stream.
+   * @tparam Range the type of the range (`std::vector<tpl::Tuple<...>>`, ...)
+   * @param range the elements of the stream
+   * @return a stream of copies of the elements of `range`
+   */
+  template<typename Range>
+  auto stream(const Range& range) {
+    using Value = std::decay_t<decltype(*std::begin(range))>;
+    return generate([first = std::begin(range), last = std::end(range)]() mutable -> std::optional<Value> {
+      if (first == last)
+        return std::nullopt;
+      return *first++;
+    });
+  }
+}
+
+#endif // T_TUPLE_STREAM_H
@@ -1,7 +1,21 @@
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "Tuple.h"
+#include "TupleConcurrent.h"
+#include "TupleParallel.h"
+#include "TrackedTuple.h"
+#include "InlineString.h"
+#include "TupleStream.h"
+#include "TupleIndex.h"
 
 /**
  * Structure utilisée pour tester les comparateurs.
@@ -80,6 +94,12 @@ TEST(Get, Classic) {
   EXPECT_EQ(t1.get<2>(), "Hello World !");
 }
 
+TEST(Get, Size) {
+  EXPECT_EQ((tpl::Tuple<int, double, std::string>::size()), 3u);
+  EXPECT_EQ(tpl::Tuple<>::size(), 0u);
+  EXPECT_EQ((tpl::Tuple<double, double>::size()), 2u);
+}
+
 TEST(Get, Affectation) {
   auto t1 = tpl::makeTuple(42, 9.4, 3.5f, std::string("Ceci est une phrase"));
   t1.get<0>() = -1;
@@ -415,3 +435,625 @@ TEST(ExempleUtilisation, inpdf) {
   EXPECT_EQ(t6.get<3>(), 20);
   EXPECT_EQ(t6.get<4>(), 20);
 }
+
+TEST(Allocator, Construct) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::pmr::polymorphic_allocator<char> alloc(&arena);
+
+  const tpl::Tuple<int, std::pmr::string> t(std::allocator_arg, alloc, 42, "Une chaine assez longue pour ne pas tenir dans la SSO");
+  EXPECT_EQ(t.get<0>(), 42);
+  EXPECT_EQ(t.get<1>(), "Une chaine assez longue pour ne pas tenir dans la SSO");
+  EXPECT_EQ(t.get<1>().get_allocator().resource(), &arena);
+
+  const tpl::Tuple<std::pmr::string, std::pmr::vector<int>> t2(std::allocator_arg, alloc);
+  EXPECT_EQ(t2.get<0>().get_allocator().resource(), &arena);
+  EXPECT_EQ(t2.get<1>().get_allocator().resource(), &arena);
+}
+
+TEST(Allocator, AllocateTuple) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::pmr::polymorphic_allocator<char> alloc(&arena);
+
+  const auto t = tpl::allocateTuple(alloc, 1.5, std::pmr::string("abc"));
+  EXPECT_EQ(t.get<0>(), 1.5);
+  EXPECT_EQ(t.get<1>(), "abc");
+  EXPECT_EQ(t.get<1>().get_allocator().resource(), &arena);
+}
+
+TEST(Allocator, PlusAndConcat) {
+  std::pmr::monotonic_buffer_resource arena;
+  const std::pmr::polymorphic_allocator<char> alloc(&arena);
+
+  const auto t1 = tpl::allocateTuple(alloc, std::pmr::string("Une chaine assez longue pour ne pas tenir dans la SSO"), 1);
+  const auto t2 = tpl::allocateTuple(alloc, std::pmr::string(" et sa suite"), 2.5);
+
+  const auto sum = tpl::allocatePlus(alloc, t1, t2);
+  EXPECT_EQ(sum, t1 + t2);
+  EXPECT_EQ(sum.get<0>().get_allocator().resource(), &arena);
+
+  const auto concat = tpl::allocateConcat(alloc, tpl::makeTuple(1), t2);
+  EXPECT_EQ(concat, tpl::makeTuple(1, std::pmr::string(" et sa suite"), 2.5));
+  EXPECT_EQ(concat.get<1>().get_allocator().resource(), &arena);
+}
+
+/**
+ * Vérifie que le conteneur donne son allocateur aux tuples qu'il contient (`std::uses_allocator`).
+ */
+TEST(Allocator, PropagatedByContainer) {
+  std::pmr::monotonic_buffer_resource arena;
+  std::pmr::vector<tpl::Tuple<int, std::pmr::string>> v(&arena);
+
+  auto t = tpl::makeTuple(1, std::pmr::string("abc"));
+  v.push_back(t);
+  v.push_back(std::move(t));
+  v.emplace_back(2, "def");
+
+  ASSERT_EQ(v.size(), 3u);
+  for (const auto& elem : v) {
+    EXPECT_EQ(elem.get<1>().get_allocator().resource(), &arena);
+  }
+  EXPECT_EQ(v[0].get<1>(), "abc");
+  EXPECT_EQ(v[1].get<1>(), "abc");
+  EXPECT_EQ(v[2].get<1>(), "def");
+}
+
+TEST(Concurrent, SpscRing) {
+  using Message = tpl::Tuple<int, int, double>;
+  constexpr int count = 10000;
+  tpl::SpscRing<Message, 64> ring;
+
+  std::thread producer([&ring] {
+    for (int i = 0; i < count; ++i) {
+      while (!ring.try_push(Message(i, -i, i * 0.5)))
+        std::this_thread::yield();
+    }
+  });
+
+  Message msg;
+  for (int i = 0; i < count; ++i) {
+    while (!ring.try_pop(msg))
+      std::this_thread::yield();
+    ASSERT_EQ(msg, Message(i, -i, i * 0.5));
+  }
+  producer.join();
+  EXPECT_FALSE(ring.try_pop(msg));
+}
+
+TEST(Concurrent, MpmcQueue) {
+  using Message = tpl::Tuple<int, int, double>;
+  constexpr int producers = 4;
+  constexpr int per_producer = 5000;
+  tpl::MpmcQueue<Message, 256> queue;
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, p] {
+      for (int i = 1; i <= per_producer; ++i) {
+        while (!queue.try_push(Message(p, i, 1.0)))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  std::atomic<long> sum{0};
+  std::atomic<int> received{0};
+  for (int c = 0; c < 4; ++c) {
+    threads.emplace_back([&queue, &sum, &received] {
+      Message msg;
+      while (received.load() < producers * per_producer) {
+        if (queue.try_pop(msg)) {
+          sum += msg.get<1>();
+          ++received;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  EXPECT_EQ(received.load(), producers * per_producer);
+  EXPECT_EQ(sum.load(), static_cast<long>(producers) * per_producer * (per_producer + 1) / 2);
+}
+
+/**
+ * Vérifie les trois stockages possibles : 8 octets, 16 octets et plus (seqlock).
+ */
+TEST(Concurrent, AtomicTuple) {
+  tpl::AtomicTuple<tpl::Tuple<int, int>> small(tpl::makeTuple(1, 2));
+  EXPECT_TRUE(decltype(small)::is_always_lock_free);
+  EXPECT_EQ(small.exchange(tpl::makeTuple(3, 4)), tpl::makeTuple(1, 2));
+  EXPECT_EQ(small.load(), tpl::makeTuple(3, 4));
+
+  tpl::AtomicTuple<tpl::Tuple<int, int, double>> medium;
+  medium.store(tpl::makeTuple(1, 2, 3.5));
+  EXPECT_EQ(medium.load(), tpl::makeTuple(1, 2, 3.5));
+
+  tpl::AtomicTuple<tpl::Tuple<double, double, double>> big;
+  EXPECT_FALSE(decltype(big)::is_always_lock_free);
+  big.store(tpl::makeTuple(1.0, 2.0, 3.0));
+  EXPECT_EQ(big.fetch_add(tpl::makeTuple(1, 1, 1)), tpl::makeTuple(1.0, 2.0, 3.0));
+  EXPECT_EQ(big.load(), tpl::makeTuple(2.0, 3.0, 4.0));
+}
+
+TEST(Concurrent, AtomicTupleFetchAdd) {
+  constexpr int threads_count = 4;
+  constexpr int per_thread = 10000;
+  tpl::AtomicTuple<tpl::Tuple<int, int, double>> medium(tpl::makeTuple(0, 0, 0.0));
+  tpl::AtomicTuple<tpl::Tuple<long, long, long>> big(tpl::makeTuple(0l, 0l, 0l));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&medium, &big] {
+      for (int i = 0; i < per_thread; ++i) {
+        medium.fetch_add(tpl::makeTuple(1, 2, 0.5));
+        big.fetch_add(tpl::makeTuple(1, 2, 3));
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  constexpr int n = threads_count * per_thread;
+  EXPECT_EQ(medium.load(), tpl::makeTuple(n, 2 * n, n * 0.5));
+  EXPECT_EQ(big.load(), tpl::makeTuple(1l * n, 2l * n, 3l * n));
+}
+
+TEST(Parallel, Reduce) {
+  std::vector<tpl::Tuple<int, double>> rows;
+  for (int i = 0; i < 1000; ++i)
+    rows.push_back(tpl::makeTuple(i, i * 0.5));
+
+  const auto init = tpl::makeTuple(10, 0.0);
+  auto expected = init;
+  for (const auto& row : rows)
+    expected += row;
+
+  for (unsigned threads = 1; threads <= 8; ++threads) {
+    EXPECT_EQ(tpl::parallel_reduce(rows, init, threads), expected);
+  }
+}
+
+TEST(Parallel, ReduceFewElements) {
+  const std::vector<tpl::Tuple<std::string>> rows = {tpl::makeTuple(std::string("a")), tpl::makeTuple(std::string("b"))};
+  EXPECT_EQ(tpl::parallel_reduce(rows, tpl::makeTuple(std::string(">")), 4), tpl::makeTuple(std::string(">ab")));
+
+  const std::vector<tpl::Tuple<int>> empty;
+  EXPECT_EQ(tpl::parallel_reduce(empty, tpl::makeTuple(7), 4), tpl::makeTuple(7));
+}
+
+/**
+ * Les éléments doivent être accumulés dans le type de `init`, comme dans la somme séquentielle.
+ */
+TEST(Parallel, ReduceWiderInit) {
+  const std::vector<tpl::Tuple<int>> rows(4, tpl::makeTuple(std::numeric_limits<int>::max()));
+  const auto expected = tpl::makeTuple(4ll * std::numeric_limits<int>::max());
+  EXPECT_EQ(tpl::parallel_reduce(rows, tpl::makeTuple(0ll), 1), expected);
+  EXPECT_EQ(tpl::parallel_reduce(rows, tpl::makeTuple(0ll), 2), expected);
+}
+
+TEST(Parallel, GroupBy) {
+  std::vector<tpl::Tuple<int, int, double>> rows;
+  for (int i = 0; i < 1000; ++i)
+    rows.push_back(tpl::makeTuple(i % 3, 1, 0.5));
+
+  const auto groups = tpl::group_by<0>(rows, 4);
+  ASSERT_EQ(groups.size(), 3u);
+  EXPECT_EQ(groups.at(tpl::makeTuple(0)), tpl::makeTuple(334, 167.0));
+  EXPECT_EQ(groups.at(tpl::makeTuple(1)), tpl::makeTuple(333, 166.5));
+  EXPECT_EQ(groups.at(tpl::makeTuple(2)), tpl::makeTuple(333, 166.5));
+}
+
+TEST(Parallel, ZeroThreads) {
+  const std::vector<tpl::Tuple<int, int>> rows = {tpl::makeTuple(1, 2), tpl::makeTuple(1, 3)};
+  EXPECT_EQ(tpl::parallel_reduce(rows, tpl::makeTuple(0, 0), 0), tpl::makeTuple(2, 5));
+
+  const auto groups = tpl::group_by<0>(rows, 0);
+  ASSERT_EQ(groups.size(), 1u);
+  EXPECT_EQ(groups.at(tpl::makeTuple(1)), tpl::makeTuple(5));
+}
+
+TEST(Parallel, GroupBySeveralKeys) {
+  const std::vector<tpl::Tuple<std::string, int, std::string, double>> rows = {
+    tpl::makeTuple(std::string("a"), 1, std::string("x"), 1.0),
+    tpl::makeTuple(std::string("b"), 2, std::string("x"), 2.0),
+    tpl::makeTuple(std::string("a"), 3, std::string("x"), 3.0),
+    tpl::makeTuple(std::string("a"), 4, std::string("y"), 4.0),
+  };
+
+  const auto groups = tpl::group_by<0, 2>(rows, 3);
+  ASSERT_EQ(groups.size(), 3u);
+  EXPECT_EQ(groups.at(tpl::makeTuple(std::string("a"), std::string("x"))), tpl::makeTuple(4, 4.0));
+  EXPECT_EQ(groups.at(tpl::makeTuple(std::string("b"), std::string("x"))), tpl::makeTuple(2, 2.0));
+  EXPECT_EQ(groups.at(tpl::makeTuple(std::string("a"), std::string("y"))), tpl::makeTuple(4, 4.0));
+}
+
+/**
+ * Vérifie que les propriétés des éléments sont conservées par le tuple.
+ */
+TEST(Trivial, Properties) {
+  using Trivial = tpl::Tuple<int, int, double>;
+  constexpr bool trivially_copyable = std::is_trivially_copyable_v<Trivial>;
+  EXPECT_EQ(trivially_copyable, true);
+  constexpr bool trivially_destructible = std::is_trivially_destructible_v<Trivial>;
+  EXPECT_EQ(trivially_destructible, true);
+  constexpr bool trivial = std::is_trivial_v<Trivial>;
+  EXPECT_EQ(trivial, true);
+  EXPECT_EQ(sizeof(Trivial), 2 * sizeof(int) + sizeof(double));
+
+  using NotTrivial = tpl::Tuple<int, std::string>;
+  constexpr bool not_trivially_copyable = std::is_trivially_copyable_v<NotTrivial>;
+  EXPECT_EQ(not_trivially_copyable, false);
+
+  constexpr bool unique_repr = std::has_unique_object_representations_v<tpl::Tuple<int, int, long>>;
+  EXPECT_EQ(unique_repr, true);
+  constexpr bool not_unique_repr = std::has_unique_object_representations_v<tpl::Tuple<int, double>>;
+  EXPECT_EQ(not_unique_repr, false);
+}
+
+/**
+ * Structure dont l'égalité ne dépend que d'un membre : elle ne doit pas être comparée avec memcmp.
+ */
+struct CountedId {
+  int id;
+  int hits;
+
+  bool operator==(const CountedId& other) const { return id == other.id; }
+};
+
+TEST(Trivial, UserEquality) {
+  constexpr bool unique_repr = std::has_unique_object_representations_v<CountedId>;
+  EXPECT_EQ(unique_repr, true);
+  EXPECT_EQ(tpl::is_bitwise_comparable_v<CountedId>, false);
+
+  const tpl::Tuple<CountedId> t1(CountedId{1, 5});
+  const tpl::Tuple<CountedId> t2(CountedId{1, 9});
+  EXPECT_TRUE(t1 == t2);
+  EXPECT_FALSE(t1 != t2);
+
+  EXPECT_EQ(tpl::is_bitwise_comparable_v<tpl::InlineString<8>>, true);
+  EXPECT_EQ((tpl::is_bitwise_comparable_v<tpl::Tuple<int, int, long>>), true);
+}
+
+TEST(Trivial, Memcpy) {
+  const auto t1 = tpl::makeTuple(1, 2, 3l);
+  unsigned char buffer[sizeof(t1)];
+  std::memcpy(buffer, &t1, sizeof(t1));
+
+  tpl::Tuple<int, int, long> t2;
+  std::memcpy(static_cast<void*>(&t2), buffer, sizeof(t2));
+  EXPECT_EQ(t1, t2);
+
+  t2.get<2>() = 4;
+  EXPECT_NE(t1, t2);
+  EXPECT_EQ(t1, tpl::makeTuple(1, 2, 3));
+}
+
+TEST(Tracked, Get) {
+  auto t = tpl::makeTrackedTuple(1, 2.0, std::string("abc"));
+  EXPECT_FALSE(t.anyDirty());
+
+  const auto& ct = t;
+  EXPECT_EQ(ct.get<0>(), 1);
+  EXPECT_FALSE(t.anyDirty());
+
+  t.get<2>() += "def";
+  EXPECT_TRUE(t.isDirty<2>());
+  EXPECT_FALSE(t.isDirty<0>());
+  EXPECT_EQ(t.tuple(), tpl::makeTuple(1, 2.0, std::string("abcdef")));
+
+  t.clearDirty();
+  t.set<0>(1);
+  EXPECT_FALSE(t.anyDirty());
+  t.set<0>(5);
+  EXPECT_TRUE(t.isDirty<0>());
+}
+
+TEST(Tracked, CompoundOperators) {
+  auto t = tpl::makeTrackedTuple(1, 2, 3, 4.0);
+
+  t += tpl::makeTuple(0, 1, 0, 0.0);
+  EXPECT_EQ(t.dirtyMask().to_ulong(), 0b0010u);
+
+  t.clearDirty();
+  t *= tpl::makeTuple(1, 1, 2, 0.5);
+  EXPECT_EQ(t.dirtyMask().to_ulong(), 0b1100u);
+  EXPECT_EQ(t.tuple(), tpl::makeTuple(1, 3, 6, 2.0));
+
+  t.clearDirty();
+  t -= tpl::makeTuple(1, 0, 0, 0);
+  t /= tpl::makeTuple(1, 1, 1, 2);
+  EXPECT_EQ(t.dirtyMask().to_ulong(), 0b1001u);
+  EXPECT_EQ(t.tuple(), tpl::makeTuple(0, 3, 6, 1.0));
+}
+
+TEST(Tracked, CompoundOperatorsChangeDetection) {
+  auto t = tpl::makeTrackedTuple(std::numeric_limits<double>::quiet_NaN(), std::string("abc"), 1);
+
+  // un NaN n'est pas marqué quand ses octets ne changent pas, une std::string est toujours marquée
+  t += tpl::makeTuple(0.0, std::string(), 0);
+  EXPECT_EQ(t.dirtyMask().to_ulong(), 0b010u);
+  EXPECT_EQ(t.get<1>(), "abc");
+}
+
+/**
+ * Exemple d'utilisation : un hash (xor des hash des éléments) mis à jour en ne recalculant que les éléments modifiés.
+ */
+TEST(Tracked, IncrementalHash) {
+  auto t = tpl::makeTrackedTuple(1, std::string("abc"), 2.5);
+  std::size_t hashes[3] = {
+    std::hash<int>{}(t.get<0>()), std::hash<std::string>{}(t.get<1>()), std::hash<double>{}(t.get<2>())
+  };
+  t.clearDirty();
+
+  int recomputed = 0;
+  const auto refresh = [&] {
+    t.forEachDirty([&](auto idx, const auto& value) {
+      hashes[idx] = std::hash<std::decay_t<decltype(value)>>{}(value);
+      ++recomputed;
+    });
+    t.clearDirty();
+    return hashes[0] ^ hashes[1] ^ hashes[2];
+  };
+
+  t += tpl::makeTuple(0, std::string("def"), 0.0);
+  const std::size_t hash = refresh();
+  EXPECT_EQ(recomputed, 1);
+  EXPECT_EQ(hash, std::hash<int>{}(1) ^ std::hash<std::string>{}("abcdef") ^ std::hash<double>{}(2.5));
+}
+
+TEST(InlineString, Operators) {
+  const tpl::Tuple<tpl::InlineString<8>, int> t1("abc", 1);
+  const tpl::Tuple<tpl::InlineString<4>, int> t2("def", 2);
+
+  const auto t3 = t1 + t2;
+  constexpr bool is_inline = std::is_same_v<decltype(t3), const tpl::Tuple<tpl::InlineString<12>, int>>;
+  EXPECT_EQ(is_inline, true);
+  EXPECT_EQ(t3.get<0>(), "abcdef");
+  EXPECT_EQ(t3.get<1>(), 3);
+
+  auto t4 = t1;
+  t4 += t2;
+  EXPECT_EQ(t4.get<0>(), "abcdef");
+  EXPECT_THROW(t4 += t2 + t2, std::length_error);
+  EXPECT_EQ(t4.get<0>(), "abcdef");
+
+  EXPECT_LT(t1, t2);
+  EXPECT_EQ(t1, tpl::makeTuple(tpl::InlineString<8>("abc"), 1));
+  EXPECT_NE(t1, tpl::makeTuple(tpl::InlineString<8>("abd"), 1));
+}
+
+TEST(InlineString, Trivial) {
+  using T = tpl::Tuple<tpl::InlineString<8>, long>;
+  constexpr bool trivially_copyable = std::is_trivially_copyable_v<T>;
+  EXPECT_EQ(trivially_copyable, true);
+
+  // Les caractères après la fin sont toujours nuls, donc la comparaison avec memcmp est correcte.
+  T t1("abcdef", 1);
+  t1.get<0>() = "ab";
+  EXPECT_EQ(t1, T("ab", 1));
+
+  // Seuls les caractères de la chaîne peuvent être modifiés par operator[].
+  t1.get<0>()[1] = 'x';
+  EXPECT_EQ(t1, T("ax", 1));
+}
+
+TEST(InlineString, Concat) {
+  auto t1 = tpl::makeTuple(tpl::InlineString<4>("abc"));
+  auto t2 = tpl::makeTuple(tpl::InlineString<4>("def"), 5);
+
+  const auto t3 = std::move(t1) | std::move(t2);
+  EXPECT_EQ(t3.get<0>(), "abc");
+  EXPECT_EQ(t3.get<1>(), "def");
+  EXPECT_EQ(t3.get<2>(), 5);
+}
+
+TEST(StringView, Elements) {
+  const std::string s1 = "abc";
+  const std::string s2 = "abd";
+  const auto t1 = tpl::makeTuple(std::string_view(s1), 1);
+  const auto t2 = tpl::makeTuple(std::string_view(s2), 1);
+  EXPECT_LT(t1, t2);
+  EXPECT_NE(t1, t2);
+
+  // Une opération arithmétique dont le résultat contiendrait une vue ne compile pas (static_assert dans plus_impl, ...).
+  EXPECT_EQ(tpl::is_view_v<std::string_view>, true);
+  EXPECT_EQ(tpl::is_view_v<std::string>, false);
+  EXPECT_EQ((tpl::has_view_v<int, const std::string_view&>), true);
+}
+
+TEST(Stream, MapFilter) {
+  std::vector<tpl::Tuple<int, double>> rows;
+  for (int i = 0; i < 10; ++i)
+    rows.push_back(tpl::makeTuple(i, i * 0.5));
+
+  std::vector<tpl::Tuple<int, double>> result;
+  tpl::stream(rows)
+    .map([](const auto& t) { return t * tpl::makeTuple(2, 2); })
+    .filter([](const auto& t) { return t >= tpl::makeTuple(14, 0.0); })
+    .forEach([&result](auto&& t) { result.push_back(t); });
+
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(result[0], tpl::makeTuple(14, 7.0));
+  EXPECT_EQ(result[2], tpl::makeTuple(18, 9.0));
+}
+
+TEST(Stream, Concat) {
+  const std::vector<tpl::Tuple<int>> ids = {tpl::makeTuple(1), tpl::makeTuple(2), tpl::makeTuple(3)};
+  const std::vector<tpl::Tuple<std::string>> names = {tpl::makeTuple(std::string("a")), tpl::makeTuple(std::string("b"))};
+
+  auto s = tpl::stream(ids).concat(tpl::stream(names));
+  std::vector<tpl::Tuple<int, std::string>> result;
+  for (auto& t : s)
+    result.push_back(t);
+
+  ASSERT_EQ(result.size(), 2u);
+  EXPECT_EQ(result[0], tpl::makeTuple(1, std::string("a")));
+  EXPECT_EQ(result[1], tpl::makeTuple(2, std::string("b")));
+}
+
+TEST(Stream, Batch) {
+  int i = 0;
+  auto s = tpl::generate([&i]() -> std::optional<tpl::Tuple<int>> {
+    if (i == 7)
+      return std::nullopt;
+    return tpl::makeTuple(i++);
+  }).batch(3);
+
+  std::vector<std::size_t> sizes;
+  for (const auto& batch : s)
+    sizes.push_back(batch.size());
+  EXPECT_EQ(sizes, (std::vector<std::size_t>{3, 3, 1}));
+}
+
+TEST(Stream, BatchZeroSize) {
+  const std::vector<tpl::Tuple<int>> rows = {tpl::makeTuple(1), tpl::makeTuple(2)};
+
+  std::size_t batches = 0;
+  tpl::stream(rows).batch(0).forEach([&batches](auto&& batch) {
+    EXPECT_EQ(batch.size(), 1u);
+    ++batches;
+  });
+  EXPECT_EQ(batches, rows.size());
+}
+
+TEST(Stream, Parallel) {
+  std::vector<tpl::Tuple<int, int>> rows;
+  for (int i = 0; i < 1000; ++i)
+    rows.push_back(tpl::makeTuple(i, 1));
+
+  std::vector<tpl::Tuple<int, int>> result;
+  tpl::stream(rows)
+    .parallel(4, [](const auto& t) { return t + t; }, 16)
+    .forEach([&result](auto&& t) { result.push_back(t); });
+
+  ASSERT_EQ(result.size(), rows.size());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(result[i], tpl::makeTuple(2 * i, 2));
+}
+
+TEST(Stream, ParallelZeroArguments) {
+  std::vector<tpl::Tuple<int>> rows;
+  for (int i = 0; i < 10; ++i)
+    rows.push_back(tpl::makeTuple(i));
+
+  std::size_t count = 0;
+  tpl::stream(rows)
+    .parallel(0, [](const auto& t) { return t; }, 0)
+    .forEach([&count](auto&&) { ++count; });
+  EXPECT_EQ(count, rows.size());
+}
+
+TEST(Index, LowerBound) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, 50);
+  std::vector<tpl::Tuple<int, int, std::string>> rows;
+  for (int i = 0; i < 1000; ++i)
+    rows.push_back(tpl::makeTuple(dist(gen), dist(gen), std::to_string(i)));
+
+  const tpl::TupleIndex index(rows);
+  std::sort(rows.begin(), rows.end());
+  ASSERT_EQ(index.size(), rows.size());
+  EXPECT_TRUE(std::equal(index.begin(), index.end(), rows.begin()));
+
+  for (int a = -1; a <= 51; ++a) {
+    const auto prefix = tpl::makeTuple(a);
+    const auto expected = std::lower_bound(rows.begin(), rows.end(), prefix, [](const auto& row, const auto& key) {
+      return row.template get<0>() < key.template get<0>();
+    });
+    EXPECT_EQ(index.lowerBound(prefix), static_cast<std::size_t>(expected - rows.begin()));
+
+    for (int b = -1; b <= 51; b += 13) {
+      const auto prefix2 = tpl::makeTuple(a, b);
+      const auto expected2 = std::lower_bound(rows.begin(), rows.end(), prefix2, [](const auto& row, const auto& key) {
+        return tpl::makeTuple(row.template get<0>(), row.template get<1>()) < key;
+      });
+      EXPECT_EQ(index.lowerBound(prefix2), static_cast<std::size_t>(expected2 - rows.begin()));
+    }
+  }
+}
+
+TEST(Index, EqualRange) {
+  const tpl::TupleIndex index(std::vector<tpl::Tuple<int, double>>{
+    tpl::makeTuple(3, 1.0), tpl::makeTuple(1, 2.0), tpl::makeTuple(3, 0.5), tpl::makeTuple(2, 0.0), tpl::makeTuple(3, 2.0)
+  });
+
+  const auto [first, last] = index.equalRange(tpl::makeTuple(3));
+  ASSERT_EQ(last - first, 3);
+  EXPECT_EQ(*first, tpl::makeTuple(3, 0.5));
+  EXPECT_EQ(*(last - 1), tpl::makeTuple(3, 2.0));
+
+  const auto [first2, last2] = index.equalRange(tpl::makeTuple(4));
+  EXPECT_EQ(first2, last2);
+  EXPECT_EQ(first2, index.end());
+  EXPECT_EQ(index.upperBound(tpl::makeTuple(0)), 0u);
+
+  const tpl::TupleIndex<tpl::Tuple<int>> empty({});
+  EXPECT_EQ(empty.lowerBound(tpl::makeTuple(1)), 0u);
+  EXPECT_EQ(empty.lowerBounds(std::vector{tpl::makeTuple(1)}), std::vector<std::size_t>{0});
+}
+
+TEST(Index, LowerBounds) {
+  std::vector<tpl::Tuple<int, int>> rows;
+  for (int i = 0; i < 500; ++i)
+    rows.push_back(tpl::makeTuple(i * 7 % 101, i));
+  const tpl::TupleIndex index(rows);
+
+  std::vector<tpl::Tuple<int>> prefixes;
+  for (int i = -5; i < 110; ++i)
+    prefixes.push_back(tpl::makeTuple(i));
+
+  const auto result = index.lowerBounds(prefixes);
+  ASSERT_EQ(result.size(), prefixes.size());
+  for (std::size_t i = 0; i < prefixes.size(); ++i)
+    EXPECT_EQ(result[i], index.lowerBound(prefixes[i]));
+}
+
+TEST(Dense, Storage) {
+  tpl::Tuple<double, double, double, double> t(1.0, 2.0, 3.0, 4.0);
+  EXPECT_EQ(t.size(), 4u);
+  EXPECT_EQ(sizeof(t), 4 * sizeof(double));
+  EXPECT_EQ(&t.get<0>(), t.data());
+  EXPECT_EQ(&t.get<3>(), t.data() + 3);
+
+  t.data()[2] = -3.0;
+  EXPECT_EQ(t.get<2>(), -3.0);
+
+  constexpr bool dense = tpl::is_dense_v<double, double, double>;
+  EXPECT_EQ(dense, true);
+  constexpr bool not_dense = tpl::is_dense_v<double, float>;
+  EXPECT_EQ(not_dense, false);
+  constexpr bool not_arithmetic = tpl::is_dense_v<std::string, std::string>;
+  EXPECT_EQ(not_arithmetic, false);
+}
+
+TEST(Dense, Operators) {
+  const tpl::Tuple<double, double, double, double, double, double, double, double> t1(1, 2, 3, 4, 5, 6, 7, 8);
+  const tpl::Tuple<int, int, int, int, int, int, int, int> t2(2, 2, 2, 2, 2, 2, 2, 2);
+
+  const auto sum = t1 + t2;
+  constexpr bool is_double = std::is_same_v<std::decay_t<decltype(sum.get<7>())>, double>;
+  EXPECT_EQ(is_double, true);
+  EXPECT_EQ(sum, tpl::makeTuple(3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0));
+  EXPECT_EQ(t1 - t2, tpl::makeTuple(-1.0, 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0));
+  EXPECT_EQ(t1 * t2, tpl::makeTuple(2.0, 4.0, 6.0, 8.0, 10.0, 12.0, 14.0, 16.0));
+  EXPECT_EQ(t1 / t2, tpl::makeTuple(0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 4.0));
+  EXPECT_NE(t1, sum);
+
+  // Les types des éléments suivent toujours les règles de promotion (char + char donne un int).
+  const auto chars = tpl::makeTuple('a', 'b') + tpl::makeTuple('\1', '\1');
+  constexpr bool is_int = std::is_same_v<decltype(chars), const tpl::Tuple<int, int>>;
+  EXPECT_EQ(is_int, true);
+  EXPECT_EQ(chars, tpl::makeTuple(98, 99));
+}
+
+TEST(Dense, DifferentSizes) {
+  const tpl::Tuple<double> small(1);
+  const tpl::Tuple<double, double, double> big(1, 2, 3);
+
+  // Comme pour les tuples non denses, seuls les éléments du tuple de gauche sont comparés
+  // (et la comparaison avec un tuple de gauche plus grand ne compile pas).
+  EXPECT_EQ(small, big);
+  EXPECT_NE(tpl::Tuple<double>(2), big);
+}